@@ -0,0 +1,43 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <pd/core/frame/DataFrame/DataFrame.hpp>
+
+namespace pd {
+    enum class Axis {
+        // Stack the rows of the frames, matching columns by name
+        kIndex,
+        // Put the columns of the frames side by side, the frames must have the same number of rows
+        kColumns
+    };
+
+    // Concatenates frames. Stacking rows takes the union of the columns in order of appearance; a column gets
+    // the common dtype of its parts (integers with floats become float64, anything else mixed becomes values)
+    // and NaN where a frame does not have it. The result has a new RangeIndex.
+    // Every output column is allocated once with its final size and filled in parallel;
+    // frames passed as rvalues give their columns away when placed side by side.
+    pd::DataFrame concat(std::vector<DataFrame> frames, Axis axis = Axis::kIndex);
+}// namespace pd
@@ -22,16 +22,27 @@ SOFTWARE.
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <pd/Exception.hpp>
 #include <pd/core/frame/DataFrame/DataFrameParameters.hpp>
+#include <pd/core/frame/Rows/Rows.hpp>
 #include <pd/core/internal/Index.hpp>
 #include <pd/core/internal/Indexing.hpp>
+#include <pd/core/internal/Parallel.hpp>
 #include <pd/core/series/Series/Series.hpp>
 
 namespace pd {
+    enum class CorrelationMethod {
+        // Linear correlation of the values
+        kPearson,
+        // Pearson correlation of the ranks of the values
+        kSpearman
+    };
+
     class DataFrame {
     public:
         DataFrame();
@@ -57,8 +68,11 @@ namespace pd {
         [[nodiscard]] np::Size size() const;
         [[nodiscard]] internal::Index index() const;
 
+        // Appending an rvalue moves its columns into the frame instead of copying them
         void append(const DataFrame &df);
+        void append(DataFrame &&df);
         void append(const Series &series);
+        void append(Series &&series);
 
         const Series &operator[](const internal::Value &column) const;
         Series &operator[](const internal::Value &column);
@@ -78,7 +92,41 @@ namespace pd {
         [[nodiscard]] DataFrame iloc(const std::string &rows) const;
         [[nodiscard]] DataFrame iloc(const std::string &rows, const std::string &columns) const;
 
+        // Row by row access without a DataFrame or Series per row, see Rows
+        [[nodiscard]] Rows itertuples() const;
+        // Numeric columns as float64 rows in batches prefetched on a background thread, see RowBatches
+        [[nodiscard]] RowBatches batches(np::Size batchSize = 4096) const;
+
+        // Numeric frame as a rows x columns float64 matrix, converted in tiles by several threads
+        [[nodiscard]] np::Array<np::float_> to_numpy() const;
+
         [[nodiscard]] internal::Value dot(const DataFrame &another) const;
+        // Matrix product of numeric frames: columns of this frame are matched with rows of another by position.
+        // The result has the columns of another and float64 values, computed by a blocked multithreaded kernel.
+        [[nodiscard]] DataFrame matmul(const DataFrame &another) const;
+
+        // Evaluates an element-wise arithmetic expression over numeric columns, e.g. df.eval("(a + b) * c - d").
+        // The expression is computed block by block in cache-sized scratch buffers instead of
+        // materializing a temporary Series per operator. The result is a float64 Series.
+        [[nodiscard]] Series eval(const std::string &expression) const;
+
+        // Window calculations over every column, columns are processed in parallel
+        [[nodiscard]] Rolling<DataFrame> rolling(np::Size window) const;
+        [[nodiscard]] Rolling<DataFrame> rolling(np::Size window, np::Size minPeriods) const;
+        [[nodiscard]] Expanding<DataFrame> expanding(np::Size minPeriods = 1) const;
+
+        // Pairwise correlation and covariance of the numeric columns, other columns are left out.
+        // Rows with NaN are excluded pair by pair; pairs with fewer than minPeriods common rows get NaN.
+        [[nodiscard]] DataFrame corr(CorrelationMethod method = CorrelationMethod::kPearson, np::Size minPeriods = 1) const;
+        [[nodiscard]] DataFrame cov(np::Size minPeriods = 1, np::Size ddof = 1) const;
+
+        // Rows at the given positions
+        [[nodiscard]] DataFrame take(const std::vector<np::Size> &rows) const;
+
+        // Whether every row repeats an earlier row (bool series)
+        [[nodiscard]] Series duplicated() const;
+        // Rows that do not repeat an earlier row
+        [[nodiscard]] DataFrame drop_duplicates() const;
 
         template<typename DType, typename Derived, typename Storage>
         DataFrame addVector(const np::ndarray::internal::NDArrayBase<DType, Derived, Storage> &array) const {
@@ -94,7 +142,7 @@ namespace pd {
                 for (np::Size i = 0; i < shape()[0]; ++i) {
                     columnArray.set(i, static_cast<DType>(at(i, columnName)) + cell);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             }
             return result;
         }
@@ -124,7 +172,7 @@ namespace pd {
                 for (np::Size i = 0; i < shape()[0]; ++i) {
                     columnArray.set(i, static_cast<DType>(at(i, columnName)) - cell);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             }
             return result;
         }
@@ -154,7 +202,7 @@ namespace pd {
                 for (np::Size i = 0; i < shape()[0]; ++i) {
                     columnArray.set(i, static_cast<DType>(at(i, columnName)) * cell);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             }
             return result;
         }
@@ -184,7 +232,7 @@ namespace pd {
                 for (np::Size i = 0; i < shape()[0]; ++i) {
                     columnArray.set(i, static_cast<DType>(at(i, columnName)) / cell);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             }
             return result;
         }
@@ -201,25 +249,51 @@ namespace pd {
         }
 
     private:
+        // Side of the square tiles of a matrix transposed into columns
+        static const constexpr np::Size kTransposeTile = 64;
+        // Smallest number of cells transposed by a separate thread
+        static const constexpr np::Size kMinTransposePerThread = 1 << 16;
+
         template<typename DType, typename Derived, typename Storage>
         void init(const np::ndarray::internal::NDArrayBase<DType, Derived, Storage> &data, const DataFrameParameters &dataFrameParameters = DataFrameParameters{}) {
-            m_index = internal::Index{dataFrameParameters.index, data.shape()[0]};
+            m_index = internal::Index{dataFrameParameters.index, dataFrameParameters.index.empty() ? data.shape()[0] : 0};
             m_shape = data.shape();
 
             if (m_shape.size() == 1) {
                 m_columns = internal::Index{dataFrameParameters.columns, 1};
                 auto column = m_columns[0];
                 auto array = data.copy();
-                m_columnData[column] = Series{array, column};
+                m_columnData[column] = Series{std::move(array), column};
             } else {
-                m_columns = internal::Index{dataFrameParameters.columns, data.shape()[1]};
-                for (np::Size i = 0; i < data.shape()[1]; ++i) {
-                    auto column = m_columns[i];
-                    np::Array<DType> array{np::Shape{data.shape()[0]}};
-                    for (np::Size j = 0; j < data.shape()[0]; ++j) {
-                        array.set(j, data.get(j * data.shape()[1] + i));
+                m_columns = internal::Index{dataFrameParameters.columns, dataFrameParameters.columns.empty() ? data.shape()[1] : 0};
+                auto rows = data.shape()[0];
+                auto columns = data.shape()[1];
+                // Every column gets a buffer of its own: copies of one array might share storage
+                std::vector<np::Array<DType>> arrays;
+                arrays.reserve(static_cast<std::size_t>(columns));
+                for (np::Size i = 0; i < columns; ++i) {
+                    arrays.emplace_back(np::Shape{rows});
+                }
+                // Threads own groups of whole columns. Within a group the data is read in tiles of
+                // kTransposeTile rows by kTransposeTile columns, so every read stays within a few cache lines
+                // of the previous one while every column is written sequentially.
+                auto minColumns = std::max<np::Size>(1, kMinTransposePerThread / std::max<np::Size>(1, rows));
+                internal::parallelFor(columns, minColumns, [&](np::Size, np::Size begin, np::Size end) {
+                    for (np::Size column0 = begin; column0 < end; column0 += kTransposeTile) {
+                        auto column1 = std::min(column0 + kTransposeTile, end);
+                        for (np::Size row0 = 0; row0 < rows; row0 += kTransposeTile) {
+                            auto row1 = std::min(row0 + kTransposeTile, rows);
+                            for (auto row = row0; row < row1; ++row) {
+                                for (auto column = column0; column < column1; ++column) {
+                                    arrays[column].set(row, data.get(row * columns + column));
+                                }
+                            }
+                        }
                     }
-                    m_columnData[column] = Series{array, column};
+                });
+                for (np::Size i = 0; i < columns; ++i) {
+                    auto column = m_columns[i];
+                    m_columnData[column] = Series{std::move(arrays[i]), column};
                 }
             }
         }
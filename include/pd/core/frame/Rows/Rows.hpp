@@ -0,0 +1,193 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <future>
+#include <iterator>
+#include <vector>
+
+#include <np/Array.hpp>
+#include <pd/Exception.hpp>
+#include <pd/core/internal/Value.hpp>
+#include <pd/core/series/Series/Series.hpp>
+
+namespace pd {
+    class DataFrame;
+
+    // A row of a frame: reads cells straight from the column buffers, nothing is allocated per row.
+    // Valid while the frame and the Rows it came from are alive and unchanged.
+    class Row {
+    public:
+        Row(const std::vector<const Series *> &columns, np::Size position)
+            : m_columns{&columns}, m_position{position} {
+        }
+
+        [[nodiscard]] np::Size position() const {
+            return m_position;
+        }
+
+        [[nodiscard]] np::Size size() const {
+            return static_cast<np::Size>(m_columns->size());
+        }
+
+        // Cell of a column with the given dtype, e.g. row.get<np::int_>(0) for an int64 column
+        template<typename DType>
+        [[nodiscard]] DType get(np::Size column) const {
+            const auto *array = static_cast<const np::Array<DType> *>((*m_columns)[column]->values());
+            if (array == nullptr) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid column type");
+            }
+            return array->get(m_position);
+        }
+
+        // Cell of a numeric column as float64
+        [[nodiscard]] np::float_ number(np::Size column) const;
+
+        [[nodiscard]] internal::Value operator[](np::Size column) const {
+            return (*m_columns)[column]->at(m_position);
+        }
+
+    private:
+        const std::vector<const Series *> *m_columns;
+        np::Size m_position;
+    };
+
+    // Rows of a frame for range-based for loops, e.g.
+    //     auto rows = df.itertuples();
+    //     auto age = rows.column("Age");
+    //     for (const auto &row: rows) { score(row.get<np::int_>(age)); }
+    // The frame must outlive the Rows.
+    class Rows {
+    public:
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Row;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Row;
+
+            Iterator(const std::vector<const Series *> &columns, np::Size position)
+                : m_columns{&columns}, m_position{position} {
+            }
+
+            Row operator*() const {
+                return Row{*m_columns, m_position};
+            }
+
+            Iterator &operator++() {
+                ++m_position;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto result = *this;
+                ++m_position;
+                return result;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return m_position == other.m_position;
+            }
+
+        private:
+            const std::vector<const Series *> *m_columns;
+            np::Size m_position;
+        };
+
+        explicit Rows(const DataFrame &df);
+
+        // Position of a column, to be resolved once before the loop
+        [[nodiscard]] np::Size column(const internal::Value &name) const;
+
+        [[nodiscard]] np::Size size() const {
+            return m_size;
+        }
+
+        [[nodiscard]] Iterator begin() const {
+            return Iterator{m_columns, 0};
+        }
+
+        [[nodiscard]] Iterator end() const {
+            return Iterator{m_columns, m_size};
+        }
+
+    private:
+        std::vector<internal::Value> m_names;
+        std::vector<const Series *> m_columns;
+        np::Size m_size{0};
+    };
+
+    // The numeric columns of a frame in batches of rows converted to float64 and laid out row by row,
+    // batch.row(i)[column], ready to be passed to a model. While a batch is processed the next one is
+    // converted on a background thread, and the buffer of a finished batch is reused.
+    //     auto batches = df.batches(4096);
+    //     while (batches.next()) { for (np::Size i = 0; i < batches.rows(); ++i) { score(batches.row(i)); } }
+    // The frame must outlive the RowBatches.
+    class RowBatches {
+    public:
+        RowBatches(const DataFrame &df, np::Size batchSize);
+
+        RowBatches(const RowBatches &) = delete;
+        RowBatches &operator=(const RowBatches &) = delete;
+
+        // Moves to the next batch, false after the last one
+        bool next();
+
+        // Position of a numeric column in a row of a batch
+        [[nodiscard]] np::Size column(const internal::Value &name) const;
+
+        [[nodiscard]] np::Size columns() const {
+            return static_cast<np::Size>(m_arrays.size());
+        }
+
+        // Position in the frame of the first row of the batch
+        [[nodiscard]] np::Size begin() const {
+            return m_current.begin;
+        }
+
+        [[nodiscard]] np::Size rows() const {
+            return m_current.rows;
+        }
+
+        [[nodiscard]] const np::float_ *row(np::Size i) const {
+            return m_current.values.data() + i * columns();
+        }
+
+    private:
+        struct Batch {
+            np::Size begin{0};
+            np::Size rows{0};
+            std::vector<np::float_> values;
+        };
+
+        [[nodiscard]] Batch load(np::Size begin, std::vector<np::float_> buffer) const;
+
+        std::vector<internal::Value> m_names;
+        std::vector<const internal::Array *> m_arrays;
+        np::Size m_size{0};
+        np::Size m_batchSize;
+        Batch m_current;
+        std::future<Batch> m_next;
+    };
+}// namespace pd
@@ -84,7 +84,7 @@ namespace pd {
                 : m_array{array} {
             }
 
-            explicit Array(np::Array<np::string_> &array)
+            explicit Array(np::Array<np::string_> &&array)
                 : m_array{std::move(array)} {
             }
 
@@ -0,0 +1,89 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include <np/Array.hpp>
+
+namespace pd {
+    namespace internal {
+        // Blocked Bloom filter: every key sets kBitsPerKey bits inside one 512-bit block selected by
+        // the high bits of its hash, so a probe touches a single cache line. Takes 64-bit hashes
+        // (see hashKey), no false negatives, about 1% false positives at 16 bits per key.
+        class BloomFilter {
+        public:
+            explicit BloomFilter(np::Size expectedSize) {
+                // 16 bits per key rounded up to a power of two of blocks
+                np::Size blocks = 1;
+                while (blocks * kBlockBits < expectedSize * 16) {
+                    blocks *= 2;
+                }
+                m_blocks.resize(blocks);
+                m_shift = 64 - static_cast<int>(std::countr_zero(blocks));
+            }
+
+            void add(std::uint64_t hash) {
+                auto &block = m_blocks[blockOf(hash)];
+                for (int i = 0; i < kBitsPerKey; ++i) {
+                    auto bit = bitOf(hash, i);
+                    block[bit / 64] |= std::uint64_t{1} << (bit % 64);
+                }
+            }
+
+            [[nodiscard]] bool mayContain(std::uint64_t hash) const {
+                const auto &block = m_blocks[blockOf(hash)];
+                for (int i = 0; i < kBitsPerKey; ++i) {
+                    auto bit = bitOf(hash, i);
+                    if ((block[bit / 64] & (std::uint64_t{1} << (bit % 64))) == 0) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            static const constexpr np::Size kBlockBits = 512;
+            static const constexpr int kBitsPerKey = 6;
+
+            using Block = std::array<std::uint64_t, kBlockBits / 64>;
+
+            [[nodiscard]] np::Size blockOf(std::uint64_t hash) const {
+                return m_shift == 64 ? 0 : static_cast<np::Size>(hash >> m_shift);
+            }
+
+            // Bit positions inside the block from 9-bit slices of the low half of the hash
+            // and a multiplicative rehash of it for the remaining ones
+            static unsigned bitOf(std::uint64_t hash, int i) {
+                auto bits = i < 3 ? hash >> (9 * i) : (hash * 0x9e3779b97f4a7c15ULL) >> (9 * (i - 3) + 10);
+                return static_cast<unsigned>(bits & (kBlockBits - 1));
+            }
+
+            std::vector<Block> m_blocks;
+            int m_shift;
+        };
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,93 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <np/Array.hpp>
+
+namespace pd {
+    namespace internal {
+        // Element-wise arithmetic expression like "(a + b) * c - 2 * d" compiled into a postfix program.
+        // Operands are column names (use backticks for names that are not identifiers, e.g. `my column` or `0`)
+        // and numeric constants; operators are + - * /, unary minus and parentheses.
+        class Expression {
+        public:
+            enum class OpCode {
+                kColumn,
+                kConstant,
+                kAdd,
+                kSubtract,
+                kMultiply,
+                kDivide,
+                kNegate
+            };
+
+            struct Instruction {
+                OpCode opCode;
+                // Offset in columns() for kColumn
+                np::Size column{0};
+                // Value for kConstant
+                np::float_ constant{0.0};
+            };
+
+            explicit Expression(const std::string &expression);
+
+            [[nodiscard]] const std::vector<Instruction> &program() const {
+                return m_program;
+            }
+
+            // Distinct column names in the order of their first appearance
+            [[nodiscard]] const std::vector<std::string> &columns() const {
+                return m_columns;
+            }
+
+            // Maximum number of intermediate results alive at the same time
+            [[nodiscard]] np::Size stackDepth() const {
+                return m_stackDepth;
+            }
+
+        private:
+            void parseExpression();
+            void parseTerm();
+            void parseUnary();
+            void parsePrimary();
+
+            void skipSpaces();
+            [[nodiscard]] bool end();
+            [[nodiscard]] char peek();
+
+            void emit(const Instruction &instruction);
+            [[nodiscard]] np::Size addColumn(const std::string &column);
+
+            std::string m_expression;
+            std::size_t m_position{0};
+
+            std::vector<Instruction> m_program;
+            std::vector<std::string> m_columns;
+            np::Size m_depth{0};
+            np::Size m_stackDepth{0};
+        };
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,48 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <np/Array.hpp>
+#include <pd/core/internal/Array.hpp>
+#include <pd/core/internal/HashTable.hpp>
+
+namespace pd {
+    namespace internal {
+        // Encoding of an array as ids of its distinct values
+        struct Factorization {
+            // Id of the value of every row
+            std::vector<np::Size> codes;
+            // Distinct values ordered by id (first appearance), same dtype as the input
+            Array uniques;
+            // Number of rows of every distinct value
+            std::vector<np::Size> counts;
+            // Id of NaN, HashTable<>::kNotFound if there are no NaNs
+            np::Size nanCode;
+        };
+
+        // One pass over the array with a hash table specialized for its dtype
+        [[nodiscard]] Factorization factorize(const Array &data);
+    }// namespace internal
+}// namespace pd
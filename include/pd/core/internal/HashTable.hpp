@@ -0,0 +1,189 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <np/Array.hpp>
+#include <pd/core/internal/Value.hpp>
+
+namespace pd {
+    namespace internal {
+        // Finalizer of splitmix64: spreads consecutive integers over all bits
+        inline std::uint64_t mixHash(std::uint64_t hash) {
+            hash ^= hash >> 30;
+            hash *= 0xbf58476d1ce4e5b9ULL;
+            hash ^= hash >> 27;
+            hash *= 0x94d049bb133111ebULL;
+            hash ^= hash >> 31;
+            return hash;
+        }
+
+        // Hash of a key of a typed column. Floats with an integral value hash like the integer,
+        // all NaNs hash alike, so Value keys that compare equal across dtypes get equal hashes.
+        template<typename Key>
+        std::uint64_t hashKey(const Key &key) {
+            if constexpr (std::is_floating_point_v<Key>) {
+                if (std::isnan(key)) {
+                    return mixHash(0x7ff8000000000000ULL);
+                }
+                if (key == std::trunc(key) && std::abs(key) < 9.2e18) {
+                    return mixHash(static_cast<std::uint64_t>(static_cast<np::int_>(key)));
+                }
+                return mixHash(std::bit_cast<std::uint64_t>(key));
+            } else if constexpr (std::is_integral_v<Key>) {
+                return mixHash(static_cast<std::uint64_t>(key));
+            } else if constexpr (std::is_same_v<Key, Value>) {
+                if (key.isBool()) {
+                    return hashKey(static_cast<np::bool_>(key));
+                } else if (key.isInt()) {
+                    return hashKey(static_cast<np::int_>(key));
+                } else if (key.isIntC()) {
+                    return hashKey(static_cast<np::intc>(key));
+                } else if (key.isSize()) {
+                    return hashKey(static_cast<np::Size>(key));
+                } else if (key.isFloat()) {
+                    return hashKey(static_cast<np::float_>(key));
+                } else if (key.isString()) {
+                    return hashKey(*static_cast<const np::string_ *>(key));
+                } else if (key.isUnicode()) {
+                    return hashKey(*static_cast<const np::unicode_ *>(key));
+                }
+                return 0;
+            } else {
+                return mixHash(std::hash<Key>{}(key));
+            }
+        }
+
+        // Key equality of a typed column: NaN equals NaN
+        template<typename Key>
+        bool equalKeys(const Key &key1, const Key &key2) {
+            if constexpr (std::is_floating_point_v<Key>) {
+                return key1 == key2 || (std::isnan(key1) && std::isnan(key2));
+            } else if constexpr (std::is_same_v<Key, Value>) {
+                if (key1.isBool() || key2.isBool()) {
+                    return key1.isBool() && key2.isBool() && static_cast<np::bool_>(key1) == static_cast<np::bool_>(key2);
+                }
+                return key1 == key2;
+            } else {
+                return key1 == key2;
+            }
+        }
+
+        // Open addressing hash table with linear probing that assigns dense ids 0, 1, 2, ... to distinct keys
+        // in the order of their first insertion. Slots keep the key hash, so a probe compares a key
+        // (possibly a long string) only when the hashes match.
+        template<typename Key>
+        class HashTable {
+        public:
+            static const constexpr np::Size kNotFound = static_cast<np::Size>(-1);
+
+            explicit HashTable(np::Size expectedSize = 0) {
+                np::Size capacity = 16;
+                while (capacity < expectedSize * 2) {
+                    capacity *= 2;
+                }
+                m_slots.resize(capacity);
+            }
+
+            // Id of the key and whether it has just been inserted
+            std::pair<np::Size, bool> insert(const Key &key) {
+                auto hash = hashKey(key);
+                auto mask = static_cast<np::Size>(m_slots.size() - 1);
+                for (auto position = static_cast<np::Size>(hash) & mask;; position = (position + 1) & mask) {
+                    auto &slot = m_slots[position];
+                    if (slot.id == kNotFound) {
+                        slot.id = static_cast<np::Size>(m_keys.size());
+                        slot.hash = hash;
+                        m_keys.push_back(key);
+                        if (m_keys.size() * 2 > m_slots.size()) {
+                            grow();
+                        }
+                        return {static_cast<np::Size>(m_keys.size() - 1), true};
+                    }
+                    if (slot.hash == hash && equalKeys<Key>(m_keys[slot.id], key)) {
+                        return {slot.id, false};
+                    }
+                }
+            }
+
+            [[nodiscard]] np::Size find(const Key &key) const {
+                return find(key, hashKey(key));
+            }
+
+            // Lookup with the hash of the key already computed by the caller
+            [[nodiscard]] np::Size find(const Key &key, std::uint64_t hash) const {
+                auto mask = static_cast<np::Size>(m_slots.size() - 1);
+                for (auto position = static_cast<np::Size>(hash) & mask;; position = (position + 1) & mask) {
+                    const auto &slot = m_slots[position];
+                    if (slot.id == kNotFound) {
+                        return kNotFound;
+                    }
+                    if (slot.hash == hash && equalKeys<Key>(m_keys[slot.id], key)) {
+                        return slot.id;
+                    }
+                }
+            }
+
+            [[nodiscard]] np::Size size() const {
+                return static_cast<np::Size>(m_keys.size());
+            }
+
+            // Keys ordered by id
+            [[nodiscard]] const std::vector<Key> &keys() const {
+                return m_keys;
+            }
+
+        private:
+            struct Slot {
+                std::uint64_t hash{0};
+                np::Size id{kNotFound};
+            };
+
+            void grow() {
+                std::vector<Slot> slots(m_slots.size() * 2);
+                auto mask = static_cast<np::Size>(slots.size() - 1);
+                for (const auto &slot: m_slots) {
+                    if (slot.id == kNotFound) {
+                        continue;
+                    }
+                    auto position = static_cast<np::Size>(slot.hash) & mask;
+                    while (slots[position].id != kNotFound) {
+                        position = (position + 1) & mask;
+                    }
+                    slots[position] = slot;
+                }
+                m_slots = std::move(slots);
+            }
+
+            std::vector<Slot> m_slots;
+            std::vector<Key> m_keys;
+        };
+    }// namespace internal
+}// namespace pd
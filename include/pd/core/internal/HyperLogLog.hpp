@@ -0,0 +1,55 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <np/Array.hpp>
+
+namespace pd {
+    namespace internal {
+        // HyperLogLog distinct count estimator over 64-bit hashes with 2^precision one-byte registers
+        // (16 KB for the default precision 14, standard error about 0.8%). Sketches with the same
+        // precision merge by taking the register-wise maximum, so chunks and threads can be sketched separately.
+        class HyperLogLog {
+        public:
+            explicit HyperLogLog(np::Size precision = 14);
+
+            void add(std::uint64_t hash);
+            void merge(const HyperLogLog &other);
+
+            // Ertl's improved estimator ("New cardinality estimation algorithms for HyperLogLog sketches"):
+            // unbiased over the whole range without empirical bias tables
+            [[nodiscard]] np::float_ estimate() const;
+
+            [[nodiscard]] np::Size precision() const {
+                return m_precision;
+            }
+
+        private:
+            np::Size m_precision;
+            std::vector<std::uint8_t> m_registers;
+        };
+    }// namespace internal
+}// namespace pd
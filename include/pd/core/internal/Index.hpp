@@ -121,6 +121,11 @@ namespace pd {
                        (value.isInt() && *static_cast<const np::int_ *>(value) >= 0 && *static_cast<const np::int_ *>(value) < static_cast<np::int_>(m_count));
             }
 
+            // Named labels of the index, empty for a range index
+            [[nodiscard]] const std::vector<internal::Value> &labels() const {
+                return m_namedIndex;
+            }
+
             [[nodiscard]] std::vector<internal::Value> getIndex() const {
                 if (!m_namedIndex.empty())
                     return m_namedIndex;
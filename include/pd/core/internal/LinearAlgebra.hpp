@@ -0,0 +1,96 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <np/Array.hpp>
+#include <pd/core/internal/Array.hpp>
+
+namespace pd {
+    namespace internal {
+        // Dense float64 matrix stored column by column, so a column is a contiguous run of rows
+        struct Matrix {
+            np::Size rows{0};
+            np::Size columns{0};
+            std::vector<np::float_> data;
+
+            [[nodiscard]] np::float_ *column(np::Size i) {
+                return data.data() + i * rows;
+            }
+
+            [[nodiscard]] const np::float_ *column(np::Size i) const {
+                return data.data() + i * rows;
+            }
+        };
+
+        // Sum of x[i] * y[i] with four independent accumulators, so the products are not serialized on one addition
+        [[nodiscard]] np::float_ dotBlock(const np::float_ *x, const np::float_ *y, np::Size size);
+
+        // Sum of x[i] * y[i] by recursive halving: the rounding error grows with the logarithm of the size
+        [[nodiscard]] np::float_ pairwiseDot(const np::float_ *x, const np::float_ *y, np::Size size);
+
+        // Kahan-Babuska (Neumaier) summation: the rounding error does not grow with the number of terms
+        struct CompensatedSum {
+            np::float_ sum{0.0};
+            np::float_ compensation{0.0};
+
+            void add(np::float_ value);
+            void merge(const CompensatedSum &other);
+
+            [[nodiscard]] np::float_ result() const {
+                return sum + compensation;
+            }
+        };
+
+        // Sums partial results of consecutive blocks pairwise, like a binary counter, in O(log n) memory
+        class PairwiseSum {
+        public:
+            void add(np::float_ value);
+
+            [[nodiscard]] np::float_ result() const;
+
+        private:
+            // m_levels[i] is a sum of 2^i blocks, or absent when the bit i of m_count is not set
+            std::vector<np::float_> m_levels;
+            np::Size m_count{0};
+        };
+
+        // Converts numeric arrays of equal size to the columns of a matrix, one thread per group of columns
+        [[nodiscard]] Matrix packColumns(const std::vector<const Array *> &arrays);
+
+        // columns x columns covariance matrix, row by row. Rows with NaN in either column are skipped pairwise,
+        // pairs with fewer than minPeriods common rows get NaN.
+        [[nodiscard]] std::vector<np::float_> covariance(Matrix matrix, np::Size ddof = 1, np::Size minPeriods = 1);
+
+        // rows x other.columns product of matrices with matrix.columns == other.rows
+        [[nodiscard]] Matrix multiply(const Matrix &matrix, const Matrix &other);
+
+        // columns x columns Pearson correlation matrix, row by row, NaN handled as by covariance
+        [[nodiscard]] std::vector<np::float_> correlation(Matrix matrix, np::Size minPeriods = 1);
+
+        // columns x columns Spearman correlation matrix: Pearson correlation of the ranks, ties get the average rank.
+        // With NaN the ranks of every pair are taken over the rows where both columns are not NaN.
+        [[nodiscard]] std::vector<np::float_> rankCorrelation(Matrix matrix, np::Size minPeriods = 1);
+    }// namespace internal
+}// namespace pd
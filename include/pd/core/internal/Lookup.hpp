@@ -0,0 +1,47 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <np/Array.hpp>
+#include <pd/core/internal/Array.hpp>
+#include <pd/core/internal/Value.hpp>
+
+namespace pd {
+    namespace internal {
+        static const constexpr np::Size kNoMatch = static_cast<np::Size>(-1);
+
+        // Position in keys of the key equal to every row of data, kNoMatch if there is none.
+        // Keys are converted to the dtype of data once (numbers across numeric dtypes, strings across string
+        // and unicode); keys that cannot be represented in it are ignored, the first of equal keys wins.
+        // The table is chosen by the keys: a linear scan for a few keys, a direct-index table for integer
+        // columns with a small key range, a typed hash table otherwise.
+        [[nodiscard]] std::vector<np::Size> lookup(const Array &data, const std::vector<Value> &keys);
+
+        // Whether every row of data equals one of values, as a packed bit mask. Values are converted like the keys
+        // of lookup; the set is probed by a compare against each value for a few of them, a bitmap for dense
+        // integer ranges, a typed hash table otherwise, with a blocked Bloom filter in front of large tables.
+        [[nodiscard]] std::vector<bool> isin(const Array &data, const std::vector<Value> &values);
+    }// namespace internal
+}// namespace pd
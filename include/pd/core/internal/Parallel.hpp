@@ -0,0 +1,87 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <np/Array.hpp>
+
+namespace pd {
+    namespace internal {
+        [[nodiscard]] inline np::Size threadCount() {
+            auto count = static_cast<np::Size>(std::thread::hardware_concurrency());
+            return count == 0 ? 1 : count;
+        }
+
+        // Number of chunks parallelFor splits [0, size) into: at most threadCount(), each at least minChunkSize long
+        [[nodiscard]] inline np::Size chunkCount(np::Size size, np::Size minChunkSize) {
+            if (size == 0) {
+                return 0;
+            }
+            np::Size chunks = std::max<np::Size>(1, size / std::max<np::Size>(1, minChunkSize));
+            return std::min(chunks, threadCount());
+        }
+
+        // Calls function(chunk, begin, end) for chunkCount(size, minChunkSize) contiguous ranges covering [0, size).
+        // The first chunk runs on the calling thread. An exception thrown by any chunk is rethrown after all chunks finish.
+        template<typename Function>
+        void parallelFor(np::Size size, np::Size minChunkSize, Function &&function) {
+            np::Size chunks = chunkCount(size, minChunkSize);
+            if (chunks <= 1) {
+                if (chunks == 1) {
+                    function(static_cast<np::Size>(0), static_cast<np::Size>(0), size);
+                }
+                return;
+            }
+
+            std::vector<std::exception_ptr> exceptions(chunks);
+            auto run = [&](np::Size chunk) {
+                np::Size begin = size * chunk / chunks;
+                np::Size end = size * (chunk + 1) / chunks;
+                try {
+                    function(chunk, begin, end);
+                } catch (...) {
+                    exceptions[chunk] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> threads;
+            threads.reserve(chunks - 1);
+            for (np::Size chunk = 1; chunk < chunks; ++chunk) {
+                threads.emplace_back(run, chunk);
+            }
+            run(0);
+            for (auto &thread: threads) {
+                thread.join();
+            }
+            for (const auto &exception: exceptions) {
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+            }
+        }
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,62 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <limits>
+
+#include <np/Array.hpp>
+#include <pd/core/internal/Array.hpp>
+
+namespace pd {
+    namespace internal {
+        // Rows processed at a time by column kernels: a few float64 blocks fit in L1 together
+        static const constexpr np::Size kBlockSize = 1024;
+
+        [[nodiscard]] bool isNumeric(const Array &array);
+
+        // Converts rows [begin, begin + count) of a numeric array to float64.
+        // Non-numeric elements of a Value array are converted to NaN.
+        void loadBlock(const Array &array, np::Size begin, np::Size count, np::float_ *block);
+
+        // Count, mean, sum of squared deviations from the mean (M2), min and max of a set of numbers.
+        // Partial moments of disjoint parts are merged with Chan's formula, so a column can be
+        // reduced in blocks and in parallel chunks in a single pass.
+        struct Moments {
+            np::Size count{0};
+            np::float_ mean{0.0};
+            np::float_ m2{0.0};
+            np::float_ min{std::numeric_limits<np::float_>::infinity()};
+            np::float_ max{-std::numeric_limits<np::float_>::infinity()};
+            // NaNs are never counted, but are remembered for skipna=false
+            bool hasNaN{false};
+
+            void add(const np::float_ *values, np::Size size);
+            void merge(const Moments &other);
+
+            [[nodiscard]] np::float_ variance(np::Size ddof = 0) const;
+        };
+
+        // Moments of a numeric array, computed in one pass over the data split across threads
+        [[nodiscard]] Moments moments(const Array &array);
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,49 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <np/Array.hpp>
+#include <pd/core/internal/Array.hpp>
+
+namespace pd {
+    namespace internal {
+        enum class ScanFunction {
+            kSum,
+            kProduct,
+            kMin,
+            kMax
+        };
+
+        // Inclusive prefix scan of a numeric array. Integer sums and products are computed in int64 (uint64 for
+        // unsigned input), min and max keep the input dtype, NaNs are skipped and stay NaN in the result.
+        // Large arrays are scanned in two passes: per-chunk totals in parallel, then each chunk is rescanned
+        // in parallel starting from the combined total of the preceding chunks.
+        [[nodiscard]] Array scan(const Array &data, ScanFunction function);
+
+        // data[i] - data[i - periods]; NaN where i - periods is out of range
+        [[nodiscard]] np::Array<np::float_> diff(const Array &data, np::int_ periods);
+
+        // data[i - periods]; NaN where i - periods is out of range
+        [[nodiscard]] np::Array<np::float_> shift(const Array &data, np::int_ periods);
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,204 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <np/Array.hpp>
+#include <pd/Exception.hpp>
+#include <pd/core/internal/HashTable.hpp>
+
+namespace pd {
+    namespace internal {
+        // Space-Saving heavy hitters sketch (Metwally et al.) with a fixed number of counters.
+        // Any key occurring more than total / capacity times is kept; a count overestimates the true one
+        // by at most the error of its counter. Sketches merge per Agarwal et al. "Mergeable summaries".
+        template<typename Key>
+        class SpaceSaving {
+        public:
+            struct Counter {
+                Key key;
+                np::Size count;
+                // Upper bound of the overestimation of count
+                np::Size error;
+            };
+
+            explicit SpaceSaving(np::Size capacity)
+                : m_capacity{capacity} {
+                if (capacity == 0) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Space-Saving capacity must be positive");
+                }
+                m_counters.reserve(capacity);
+            }
+
+            void add(const Key &key, np::Size count = 1) {
+                auto it = m_positions.find(key);
+                if (it != m_positions.end()) {
+                    m_counters[it->second].count += count;
+                    siftDown(it->second);
+                    return;
+                }
+                if (m_counters.size() < m_capacity) {
+                    m_counters.push_back(Counter{key, count, 0});
+                    m_positions[key] = m_counters.size() - 1;
+                    siftUp(m_counters.size() - 1);
+                    return;
+                }
+                // The least frequent key is evicted, the newcomer inherits its count as the error
+                auto &minimum = m_counters.front();
+                m_positions.erase(minimum.key);
+                minimum = Counter{key, minimum.count + count, minimum.count};
+                m_positions[key] = 0;
+                siftDown(0);
+            }
+
+            void merge(const SpaceSaving &other) {
+                // A key missing from a full sketch may still have occurred up to its minimum count
+                auto minimum = full() ? m_counters.front().count : 0;
+                auto otherMinimum = other.full() ? other.m_counters.front().count : 0;
+
+                std::vector<Counter> counters;
+                counters.reserve(m_counters.size() + other.m_counters.size());
+                for (const auto &counter: m_counters) {
+                    auto it = other.m_positions.find(counter.key);
+                    if (it != other.m_positions.end()) {
+                        const auto &otherCounter = other.m_counters[it->second];
+                        counters.push_back(Counter{counter.key, counter.count + otherCounter.count, counter.error + otherCounter.error});
+                    } else {
+                        counters.push_back(Counter{counter.key, counter.count + otherMinimum, counter.error + otherMinimum});
+                    }
+                }
+                for (const auto &otherCounter: other.m_counters) {
+                    if (!m_positions.contains(otherCounter.key)) {
+                        counters.push_back(Counter{otherCounter.key, otherCounter.count + minimum, otherCounter.error + minimum});
+                    }
+                }
+                std::sort(counters.begin(), counters.end(), [](const Counter &counter1, const Counter &counter2) {
+                    return counter1.count > counter2.count;
+                });
+                if (counters.size() > m_capacity) {
+                    counters.resize(m_capacity);
+                }
+
+                m_counters.clear();
+                m_positions.clear();
+                for (const auto &counter: counters) {
+                    m_counters.push_back(counter);
+                    m_positions[counter.key] = m_counters.size() - 1;
+                    siftUp(m_counters.size() - 1);
+                }
+            }
+
+            // Up to k most frequent keys, most frequent first
+            [[nodiscard]] std::vector<Counter> top(np::Size k) const {
+                auto counters = m_counters;
+                std::sort(counters.begin(), counters.end(), [](const Counter &counter1, const Counter &counter2) {
+                    return counter1.count > counter2.count;
+                });
+                if (counters.size() > k) {
+                    counters.resize(k);
+                }
+                return counters;
+            }
+
+            [[nodiscard]] np::Size capacity() const {
+                return m_capacity;
+            }
+
+            // The same sketch with every key converted, counts and errors kept
+            template<typename Other, typename Convert>
+            [[nodiscard]] SpaceSaving<Other> convertKeys(Convert convert) const {
+                SpaceSaving<Other> result{m_capacity};
+                for (const auto &counter: m_counters) {
+                    result.m_counters.push_back(typename SpaceSaving<Other>::Counter{convert(counter.key), counter.count, counter.error});
+                    result.m_positions[result.m_counters.back().key] = result.m_counters.size() - 1;
+                }
+                return result;
+            }
+
+        private:
+            template<typename>
+            friend class SpaceSaving;
+
+            struct KeyHash {
+                std::size_t operator()(const Key &key) const {
+                    return static_cast<std::size_t>(hashKey(key));
+                }
+            };
+
+            struct KeyEqual {
+                bool operator()(const Key &key1, const Key &key2) const {
+                    return equalKeys<Key>(key1, key2);
+                }
+            };
+
+            [[nodiscard]] bool full() const {
+                return m_counters.size() == m_capacity;
+            }
+
+            // m_counters is a binary min-heap by count, m_positions follows the moves
+            void swapCounters(std::size_t position1, std::size_t position2) {
+                std::swap(m_counters[position1], m_counters[position2]);
+                m_positions[m_counters[position1].key] = position1;
+                m_positions[m_counters[position2].key] = position2;
+            }
+
+            void siftUp(std::size_t position) {
+                while (position > 0) {
+                    auto parent = (position - 1) / 2;
+                    if (m_counters[parent].count <= m_counters[position].count) {
+                        return;
+                    }
+                    swapCounters(parent, position);
+                    position = parent;
+                }
+            }
+
+            void siftDown(std::size_t position) {
+                while (true) {
+                    auto smallest = position;
+                    auto left = 2 * position + 1;
+                    auto right = left + 1;
+                    if (left < m_counters.size() && m_counters[left].count < m_counters[smallest].count) {
+                        smallest = left;
+                    }
+                    if (right < m_counters.size() && m_counters[right].count < m_counters[smallest].count) {
+                        smallest = right;
+                    }
+                    if (smallest == position) {
+                        return;
+                    }
+                    swapCounters(smallest, position);
+                    position = smallest;
+                }
+            }
+
+            np::Size m_capacity;
+            std::vector<Counter> m_counters;
+            std::unordered_map<Key, std::size_t, KeyHash, KeyEqual> m_positions;
+        };
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,128 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace pd {
+    namespace internal {
+        // Bounded byte queue between one producer thread and one consumer thread. Positions are lock-free
+        // counters on separate cache lines; a side that finds the buffer full or empty sleeps on the event
+        // counter of the other side (C++20 atomic wait), so neither spins and neither takes a lock.
+        class SpscRingBuffer {
+        public:
+            explicit SpscRingBuffer(std::size_t capacity)
+                : m_data{std::make_unique<char[]>(capacity)}, m_capacity{capacity} {
+            }
+
+            SpscRingBuffer(const SpscRingBuffer &) = delete;
+            SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+            // Producer: copies all the data, waiting for free space. Returns false if the consumer has stopped.
+            bool write(const char *data, std::size_t size) {
+                std::size_t head = m_head.load(std::memory_order_relaxed);
+                while (size > 0) {
+                    auto events = m_readEvents.load(std::memory_order_acquire);
+                    if (m_stopped.load(std::memory_order_acquire)) {
+                        return false;
+                    }
+                    std::size_t free = m_capacity - (head - m_tail.load(std::memory_order_acquire));
+                    if (free == 0) {
+                        m_readEvents.wait(events, std::memory_order_acquire);
+                        continue;
+                    }
+                    std::size_t offset = head % m_capacity;
+                    std::size_t count = std::min({size, free, m_capacity - offset});
+                    std::memcpy(m_data.get() + offset, data, count);
+                    data += count;
+                    size -= count;
+                    head += count;
+                    m_head.store(head, std::memory_order_release);
+                    signal(m_writeEvents);
+                }
+                return true;
+            }
+
+            // Producer: no more data will be written
+            void close() {
+                m_closed.store(true, std::memory_order_release);
+                signal(m_writeEvents);
+            }
+
+            // Consumer: waits for data and passes the longest contiguous readable part to callback(data, size),
+            // which may keep using it only until it returns. Returns false once the buffer is closed and empty.
+            template<typename Callback>
+            bool read(Callback &&callback) {
+                std::size_t tail = m_tail.load(std::memory_order_relaxed);
+                while (true) {
+                    auto events = m_writeEvents.load(std::memory_order_acquire);
+                    // Checked before the head: the last write is visible once the buffer is seen closed
+                    bool closed = m_closed.load(std::memory_order_acquire);
+                    std::size_t head = m_head.load(std::memory_order_acquire);
+                    if (head != tail) {
+                        std::size_t offset = tail % m_capacity;
+                        std::size_t count = std::min(head - tail, m_capacity - offset);
+                        callback(static_cast<const char *>(m_data.get() + offset), count);
+                        m_tail.store(tail + count, std::memory_order_release);
+                        signal(m_readEvents);
+                        return true;
+                    }
+                    if (closed) {
+                        return false;
+                    }
+                    m_writeEvents.wait(events, std::memory_order_acquire);
+                }
+            }
+
+            // Consumer: no more data will be read; a waiting producer returns
+            void stop() {
+                m_stopped.store(true, std::memory_order_release);
+                signal(m_readEvents);
+            }
+
+        private:
+            static const constexpr std::size_t kCacheLineSize = 64;
+
+            static void signal(std::atomic<std::uint32_t> &events) {
+                events.fetch_add(1, std::memory_order_release);
+                events.notify_one();
+            }
+
+            std::unique_ptr<char[]> m_data;
+            std::size_t m_capacity;
+            // Total number of bytes written and read; the buffer holds head - tail bytes
+            alignas(kCacheLineSize) std::atomic<std::size_t> m_head{0};
+            alignas(kCacheLineSize) std::atomic<std::size_t> m_tail{0};
+            // Bumped by every change a waiting side must see
+            alignas(kCacheLineSize) std::atomic<std::uint32_t> m_writeEvents{0};
+            alignas(kCacheLineSize) std::atomic<std::uint32_t> m_readEvents{0};
+            std::atomic_bool m_closed{false};
+            std::atomic_bool m_stopped{false};
+        };
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,74 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include <np/Array.hpp>
+
+namespace pd {
+    namespace internal {
+        // Merging t-digest (Dunning, "Computing extremely accurate quantiles using t-digests").
+        // Keeps a bounded number of weighted centroids, small near the tails, so high and low quantiles
+        // stay accurate. Digests of disjoint parts of the data (threads, files, chunks) can be merged.
+        class TDigest {
+        public:
+            explicit TDigest(np::float_ compression = 100.0);
+
+            void add(np::float_ value, np::float_ weight = 1.0);
+            void add(const np::float_ *values, np::Size size);
+            void merge(const TDigest &other);
+
+            // Approximate q-th quantile, 0 <= q <= 1; NaN for an empty digest
+            [[nodiscard]] np::float_ quantile(np::float_ q) const;
+
+            [[nodiscard]] np::float_ count() const;
+            [[nodiscard]] np::float_ min() const {
+                return m_min;
+            }
+            [[nodiscard]] np::float_ max() const {
+                return m_max;
+            }
+            [[nodiscard]] np::float_ compression() const {
+                return m_compression;
+            }
+
+        private:
+            struct Centroid {
+                np::float_ mean;
+                np::float_ weight;
+            };
+
+            void compress() const;
+
+            np::float_ m_compression;
+            np::float_ m_min{std::numeric_limits<np::float_>::infinity()};
+            np::float_ m_max{-std::numeric_limits<np::float_>::infinity()};
+            // Centroids are sorted by mean; new points wait in the buffer until the next compression
+            mutable std::vector<Centroid> m_centroids;
+            mutable std::vector<Centroid> m_buffer;
+            mutable np::float_ m_weight{0.0};
+        };
+    }// namespace internal
+}// namespace pd
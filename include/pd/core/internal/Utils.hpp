@@ -25,6 +25,8 @@ SOFTWARE.
 #include <algorithm>
 #include <cctype>
 #include <locale>
+#include <string>
+#include <string_view>
 
 namespace pd {
     namespace internal {
@@ -48,12 +50,20 @@ namespace pd {
             return ltrim(rtrim(s));
         }
 
-        inline bool strcompci(const std::string &s1, const std::string &s2) {
-            std::string s1Upper;
-            std::transform(s1.cbegin(), s1.cend(), std::back_inserter(s1Upper), [](char c) { return static_cast<char>(std::toupper(c)); });
-            std::string s2Upper;
-            std::transform(s2.cbegin(), s2.cend(), std::back_inserter(s2Upper), [](char c) { return static_cast<char>(std::toupper(c)); });
-            return s1Upper == s2Upper;
+        inline std::string_view trim(std::string_view s) {
+            while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) {
+                s.remove_prefix(1);
+            }
+            while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) {
+                s.remove_suffix(1);
+            }
+            return s;
+        }
+
+        inline bool strcompci(std::string_view s1, std::string_view s2) {
+            return s1.size() == s2.size() && std::equal(s1.cbegin(), s1.cend(), s2.cbegin(), [](char c1, char c2) {
+                       return std::toupper(static_cast<unsigned char>(c1)) == std::toupper(static_cast<unsigned char>(c2));
+                   });
         }
     }// namespace internal
 }// namespace pd
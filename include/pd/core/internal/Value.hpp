@@ -1262,7 +1262,9 @@ namespace std {
     template<>
     struct hash<pd::internal::Value> {
         std::size_t operator()(const pd::internal::Value &value) const {
-            if (value.isInt()) {
+            if (value.isBool()) {
+                return hash<np::bool_>()(*static_cast<const np::bool_ *>(value));
+            } else if (value.isInt()) {
                 return hash<np::int_>()(*static_cast<const np::int_ *>(value));
             } else if (value.isIntC()) {
                 return hash<np::intc>()(*static_cast<const np::intc *>(value));
@@ -0,0 +1,66 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+
+            // Incremental decoder of "Transfer-Encoding: chunked" bodies. Accepts the body in pieces of any
+            // size and passes the chunk payloads to the callback without buffering them.
+            class ChunkedDecoder {
+            public:
+                using Callback = std::function<void(const char *data, std::size_t size)>;
+
+                // Returns the number of bytes consumed: less than size only when the body ends inside the data
+                std::size_t decode(const char *data, std::size_t size, const Callback &callback);
+
+                [[nodiscard]] bool isComplete() const {
+                    return m_state == State::kComplete;
+                }
+
+            private:
+                enum class State {
+                    kSize,
+                    kExtension,
+                    kSizeLineFeed,
+                    kData,
+                    kDataCarriageReturn,
+                    kDataLineFeed,
+                    kTrailer,
+                    kComplete
+                };
+
+                void onSizeLine();
+
+                State m_state{State::kSize};
+                std::size_t m_chunkSize{0};
+                std::size_t m_sizeDigits{0};
+                std::size_t m_trailerLineLength{0};
+            };
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
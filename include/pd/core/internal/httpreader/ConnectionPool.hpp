@@ -0,0 +1,96 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <pd/core/internal/httpreader/Initializer.hpp>
+#include <pd/core/internal/httpreader/Stream.hpp>
+#include <pd/core/internal/httpreader/UriParser.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+
+            // Process-wide store of idle keep-alive connections, keyed by scheme, host and port.
+            // A handler takes a connection from here instead of connecting when one is available and
+            // returns it after a response that leaves the connection open, so repeated requests to
+            // the same host skip the TCP and TLS handshakes.
+            class ConnectionPool {
+            public:
+                static ConnectionPool &instance();
+
+                ConnectionPool(const ConnectionPool &) = delete;
+                ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+                // Returns an idle connection to the host of the uri or nullptr if there is none
+                StreamPtr acquire(const Uri &uri);
+
+                void release(const Uri &uri, StreamPtr stream);
+
+                // Closes all idle connections
+                void clear();
+
+            private:
+                ConnectionPool() = default;
+
+                struct Key {
+                    Scheme scheme;
+                    std::string host;
+                    std::uint16_t port;
+
+                    bool operator==(const Key &another) const {
+                        return scheme == another.scheme && port == another.port && host == another.host;
+                    }
+                };
+
+                struct KeyHash {
+                    std::size_t operator()(const Key &key) const {
+                        return std::hash<std::string>{}(key.host) ^ (static_cast<std::size_t>(key.port) << 4) ^ static_cast<std::size_t>(key.scheme);
+                    }
+                };
+
+                struct Connection {
+                    StreamPtr stream;
+                    std::chrono::steady_clock::time_point idleSince;
+                };
+
+                static Key makeKey(const Uri &uri);
+
+                static const constexpr std::size_t kMaxIdlePerHost = 16;
+                static const constexpr std::chrono::seconds kMaxIdleTime{30};
+
+                // Keeps the socket library initialized while connections are idle
+                Initializer m_initializer;
+                std::mutex m_mutex;
+                std::unordered_map<Key, std::vector<Connection>, KeyHash> m_idle;
+            };
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
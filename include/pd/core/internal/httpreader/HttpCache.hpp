@@ -0,0 +1,83 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include <pd/core/internal/httpreader/HttpMessage.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+
+            // Directory of downloaded bodies keyed by url. Each entry is a body file and a metadata file
+            // holding the url and the validators the server sent with the body, so that the next download
+            // of the url can be made conditional and replaced by the cached body on 304 Not Modified.
+            class HttpCache {
+            public:
+                struct Entry {
+                    std::filesystem::path body;
+                    CacheValidators validators;
+                };
+
+                // Stores a body as it is downloaded. Writes to a temporary file that replaces the entry
+                // on commit(), so a failed download or a concurrent reader never sees a partial body.
+                class Writer {
+                public:
+                    Writer(const HttpCache &cache, const std::string &url);
+
+                    Writer(const Writer &) = delete;
+                    Writer &operator=(const Writer &) = delete;
+
+                    ~Writer();
+
+                    void write(const char *data, std::size_t size);
+
+                    // Replaces the entry of the url; a body without validators is not stored
+                    void commit(const CacheValidators &validators);
+
+                private:
+                    std::filesystem::path m_base;
+                    std::string m_url;
+                    std::filesystem::path m_temporary;
+                    std::ofstream m_stream;
+                    bool m_committed{false};
+                };
+
+                // Creates the directory if it does not exist
+                explicit HttpCache(std::filesystem::path directory);
+
+                [[nodiscard]] std::optional<Entry> find(const std::string &url) const;
+
+            private:
+                // The path of the entry without an extension
+                [[nodiscard]] std::filesystem::path base(const std::string &url) const;
+
+                std::filesystem::path m_directory;
+            };
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
@@ -23,6 +23,7 @@ SOFTWARE.
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <pd/core/internal/httpreader/Handler.hpp>
@@ -35,7 +36,9 @@ namespace pd {
             class HttpHandler : public Handler {
             public:
                 HttpHandler(const std::string &userAgent,
-                            const Uri &uri, HttpReader::Callback callback, HttpReader::RedirectCallback redirectCallback);
+                            const Uri &uri, HttpReader::Callback callback, HttpReader::RedirectCallback redirectCallback,
+                            HttpMessage::Method method = HttpMessage::Method::kGet, const std::optional<ByteRange> &range = std::nullopt,
+                            const CacheValidators &validators = {});
 
                 void handle(short revents) override;
 
@@ -50,17 +53,32 @@ namespace pd {
                     m_mode = Mode::kWrite;
                 }
 
+                // Ends the exchange before the response is complete: the connection is not reused
+                void stop() {
+                    m_mode = Mode::kFinish;
+                }
+
                 [[nodiscard]] bool isFinished() const override {
                     return m_mode == Mode::kFinish;
                 }
 
+                [[nodiscard]] const HttpMessage *response() const {
+                    return m_reader->response();
+                }
+
             protected:
                 [[nodiscard]] StreamPtr getStream() const override {
                     return m_stream;
                 }
 
             private:
+                void exchange(short revents);
+
+                Uri m_uri;
+                HttpMessage::Method m_method;
                 StreamPtr m_stream;
+                // Taken from the connection pool rather than connected for this request
+                bool m_reused{false};
                 std::unique_ptr<HttpReader> m_reader;
                 std::unique_ptr<HttpWriter> m_writer;
 
@@ -0,0 +1,66 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <pd/core/internal/httpreader/HttpMessage.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+
+            // Incremental parser of an HTTP message header. Accepts the header in pieces of any size, parses
+            // every complete line in place and keeps only a line split between pieces until its end arrives.
+            class HttpHeaderParser {
+            public:
+                static const constexpr std::size_t kMaxHttpHeaderSize = 100 * 1024;
+
+                explicit HttpHeaderParser(HttpMessage &message)
+                    : m_message{message} {
+                }
+
+                // Returns the number of bytes consumed: less than size only when the header ends inside the data
+                std::size_t parse(const char *data, std::size_t size);
+
+                [[nodiscard]] bool isComplete() const {
+                    return m_complete;
+                }
+
+                [[nodiscard]] std::size_t headerSize() const {
+                    return m_headerSize;
+                }
+
+            private:
+                void onLine(std::string_view line);
+
+                HttpMessage &m_message;
+                std::string m_partialLine;
+                std::size_t m_headerSize{0};
+                bool m_complete{false};
+            };
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
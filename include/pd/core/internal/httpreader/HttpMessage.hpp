@@ -23,8 +23,10 @@ SOFTWARE.
 #pragma once
 
 #include <chrono>
+#include <optional>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -35,6 +37,25 @@ namespace pd {
     namespace internal {
         namespace httpreader {
 
+            /// Inclusive range of body bytes requested with a Range header
+            struct ByteRange {
+                std::size_t first{0};
+                std::size_t last{0};
+                /// When not empty, sent as If-Range: a server holding another version sends the whole body instead
+                std::string ifRange{};
+            };
+
+            /// Identifies a version of a resource: a response carries it in ETag and Last-Modified,
+            /// a request revalidating a cached copy sends it in If-None-Match and If-Modified-Since
+            struct CacheValidators {
+                std::string etag;
+                std::string lastModified;
+
+                [[nodiscard]] bool empty() const {
+                    return etag.empty() && lastModified.empty();
+                }
+            };
+
             struct HttpMessage {
                 enum class Type {
                     kNone,
@@ -77,6 +98,13 @@ namespace pd {
                     kNumContextTransferEncodings
                 };
 
+                /// Compression of the body
+                enum class ContentEncoding {
+                    kIdentity,
+                    kGzip,
+                    kDeflate
+                };
+
                 /// Supported status codes for HTTP response according to RFC
                 /// (see http://www.ietf.org/rfc/rfc2616.txt)
                 enum class StatusCodes {
@@ -147,7 +175,14 @@ namespace pd {
                     return m_wellFormed;
                 }
 
-                void parseLine(std::string &line);
+                // Whether the connection stays open after this message
+                [[nodiscard]] bool isKeepAlive() const {
+                    return m_httpVersion == HttpVersion{"HTTP", 1, 0} ? m_connectionKeepAlive : !m_connectionClose;
+                }
+
+                void parseLine(std::string_view line);
+
+                void parseContentRange(std::string_view value);
 
                 void parseCookies(const std::string &string);
 
@@ -176,6 +211,17 @@ namespace pd {
                 ContentTransferEncoding m_contentTransferEncoding{ContentTransferEncoding::kNone};
                 bool m_wellFormed{false};
                 std::size_t m_contentLength{0};
+                bool m_hasContentLength{false};
+                bool m_chunked{false};
+                bool m_acceptRanges{false};
+                bool m_connectionClose{false};
+                bool m_connectionKeepAlive{false};
+                std::optional<ByteRange> m_range;
+                /// Range of the body of a 206 response and the size of the whole body, 0 if unknown
+                std::optional<ByteRange> m_contentRange;
+                std::size_t m_completeLength{0};
+                CacheValidators m_validators;
+                ContentEncoding m_contentEncoding{ContentEncoding::kIdentity};
                 std::size_t m_headerSize{0};
                 std::chrono::time_point<std::chrono::system_clock> m_dateTime{std::chrono::system_clock::now()};
                 std::unordered_map<std::string, std::string> m_cookies;
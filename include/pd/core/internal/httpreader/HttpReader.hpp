@@ -27,21 +27,27 @@ SOFTWARE.
 #include <sstream>
 #include <string>
 #include <utility>
-#include <vector>
 
+#include <pd/core/internal/httpreader/ChunkedDecoder.hpp>
 #include <pd/core/internal/httpreader/Handler.hpp>
+#include <pd/core/internal/httpreader/HttpHeaderParser.hpp>
 #include <pd/core/internal/httpreader/HttpMessage.hpp>
+#include <pd/core/internal/httpreader/Inflater.hpp>
 
 namespace pd {
     namespace internal {
         namespace httpreader {
 
+            // Reads an HTTP response. Once the header is parsed the body is passed to the callback
+            // piece by piece as it arrives, so a body of any size is processed in bounded memory.
+            // Chunked transfer coding and gzip/deflate content coding are removed on the way.
             class HttpReader {
             public:
-                using Callback = std::function<void(const std::vector<char> &buffer)>;
+                using Callback = std::function<void(const char *data, std::size_t size)>;
                 using RedirectCallback = std::function<void(const std::string &redirectUrl)>;
-                explicit HttpReader(Callback callback, RedirectCallback redirectCallback)
-                    : m_callback{std::move(callback)}, m_redirectCallback{std::move(redirectCallback)} {
+                explicit HttpReader(Callback callback, RedirectCallback redirectCallback, HttpMessage::Method method = HttpMessage::Method::kGet)
+                    : m_callback{std::move(callback)}, m_redirectCallback{std::move(redirectCallback)}, m_method{method},
+                      m_httpMessage{std::make_unique<HttpMessage>()}, m_headerParser{*m_httpMessage} {
                 }
 
                 void read(const StreamPtr &stream);
@@ -49,19 +55,48 @@ namespace pd {
                     return m_complete;
                 }
 
+                // Whether the connection can carry the next request: the message ended at its declared end
+                // without the peer closing the connection or sending anything after it
+                [[nodiscard]] bool isKeepAlive() const {
+                    return m_complete && !m_closed && !m_overrun && m_httpMessage->isKeepAlive();
+                }
+
+                // Whether any byte of the response has arrived; until then a failed request can be sent again
+                [[nodiscard]] bool hasReceived() const {
+                    return m_received;
+                }
+
+                // The parsed response header, nullptr until it has been received
+                [[nodiscard]] const HttpMessage *response() const {
+                    return m_headerParser.isComplete() ? m_httpMessage.get() : nullptr;
+                }
+
             private:
-                bool findHeader();
+                // HEAD, 1xx, 204 and 304 responses end with the header whatever it declares
+                [[nodiscard]] bool hasBody() const;
+                void onHeader();
+                void onBody(const char *data, std::size_t size);
+                void onContent(const char *data, std::size_t size);
+                void deliver(const char *data, std::size_t size);
+                [[nodiscard]] bool isBodyComplete() const;
                 void onMessageComplete();
 
+                bool m_received{false};
                 bool m_complete{false};
+                bool m_closed{false};
+                bool m_overrun{false};
 
                 Callback m_callback;
                 RedirectCallback m_redirectCallback;
+                HttpMessage::Method m_method;
                 std::unique_ptr<HttpMessage> m_httpMessage;
-
-                std::vector<char> m_readBuffer;
-                bool m_headerFound{false};
-                std::size_t m_totalLength{0};
+                HttpHeaderParser m_headerParser;
+                bool m_redirect{false};
+                std::size_t m_bodyLength{0};
+                std::unique_ptr<ChunkedDecoder> m_chunkedDecoder;
+                std::unique_ptr<Inflater> m_inflater;
+                // Body of a base64 encoded message, decoded as a whole at the end
+                std::string m_encodedBody;
             };
 
             using HttpReadHandlerPtr = std::shared_ptr<HttpReader>;
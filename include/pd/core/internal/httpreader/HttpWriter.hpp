@@ -23,6 +23,7 @@ SOFTWARE.
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -58,6 +59,16 @@ namespace pd {
 
                 void write(const StreamPtr &stream);
 
+                // Requests only a part of the body; must be called before request()
+                void setRange(const ByteRange &range) {
+                    m_range = range;
+                }
+
+                // Makes the request conditional on the resource having changed; must be called before request()
+                void setValidators(const CacheValidators &validators) {
+                    m_validators = validators;
+                }
+
                 bool isWriteComplete() const {
                     return m_writeComplete;
                 }
@@ -71,6 +82,8 @@ namespace pd {
 
                 std::string m_userAgent;
                 Uri m_uri;
+                std::optional<ByteRange> m_range;
+                CacheValidators m_validators;
 
                 std::unique_ptr<HttpMessage> m_httpMessage;
 
@@ -23,6 +23,7 @@ SOFTWARE.
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include <pd/core/internal/httpreader/Handler.hpp>
 #include <pd/core/internal/httpreader/HttpReader.hpp>
@@ -36,7 +37,9 @@ namespace pd {
             class HttpsHandler : public Handler {
             public:
                 HttpsHandler(const std::string &userAgent,
-                             const Uri &uri, const HttpReader::Callback &callback, const HttpReader::RedirectCallback &redirectCallback);
+                             const Uri &uri, const HttpReader::Callback &callback, const HttpReader::RedirectCallback &redirectCallback,
+                             HttpMessage::Method method = HttpMessage::Method::kGet, const std::optional<ByteRange> &range = std::nullopt,
+                             const CacheValidators &validators = {});
 
                 void handle(short revents) override;
 
@@ -51,20 +54,35 @@ namespace pd {
                     m_mode = Mode::kWrite;
                 }
 
+                // Ends the exchange before the response is complete: the connection is not reused
+                void stop() {
+                    m_mode = Mode::kFinish;
+                }
+
                 [[nodiscard]] bool isFinished() const override {
                     return m_mode == Mode::kFinish;
                 }
 
+                [[nodiscard]] const HttpMessage *response() const {
+                    return m_reader->response();
+                }
+
             protected:
                 [[nodiscard]] StreamPtr getStream() const override {
                     return m_sslStream;
                 }
 
             private:
+                void exchange(short revents);
+
+                Uri m_uri;
+                HttpMessage::Method m_method;
                 std::unique_ptr<HttpReader> m_reader;
                 std::unique_ptr<HttpWriter> m_writer;
 
                 SslStreamPtr m_sslStream;
+                // Taken from the connection pool rather than connected for this request
+                bool m_reused{false};
 
                 enum class Mode {
                     kNone,
@@ -0,0 +1,74 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <zlib.h>
+
+#include <pd/core/internal/httpreader/HttpMessage.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+
+            // Streaming decompressor of "Content-Encoding: gzip" and "deflate" bodies.
+            // Compressed input of any size is inflated through a fixed output buffer.
+            class Inflater {
+            public:
+                using Callback = std::function<void(const char *data, std::size_t size)>;
+
+                explicit Inflater(HttpMessage::ContentEncoding encoding);
+
+                Inflater(const Inflater &) = delete;
+                Inflater &operator=(const Inflater &) = delete;
+
+                ~Inflater();
+
+                void inflate(const char *data, std::size_t size, const Callback &callback);
+
+                // At the end of the stream, or of a member for gzip: more members may follow
+                [[nodiscard]] bool isComplete() const {
+                    return m_complete;
+                }
+
+            private:
+                void init(int windowBits);
+
+                static const constexpr std::size_t kOutputSize = 64 * 1024;
+
+                HttpMessage::ContentEncoding m_encoding;
+                z_stream m_stream{};
+                bool m_initialized{false};
+                // The first bytes of a deflate body, replayed if it turns out to be raw
+                std::string m_header;
+                bool m_raw{false};
+                bool m_complete{false};
+                std::array<char, kOutputSize> m_output{};
+            };
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
@@ -23,17 +23,28 @@ SOFTWARE.
 #pragma once
 
 #include <atomic>
-#include <unordered_set>
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
 
 #include <pd/core/internal/httpreader/Handler.hpp>
 
 namespace pd {
     namespace internal {
         namespace httpreader {
+            // Event loop over the sockets of registered handlers. On Linux readiness comes from epoll, so a wakeup
+            // costs O(ready handlers) rather than O(registered handlers); poll() is the fallback elsewhere.
+            // Every handler has an inactivity timer: a handler without events for its timeout fails the loop.
             class Poll {
             public:
-                Poll() = default;
-                ~Poll() = default;
+                using Clock = std::chrono::steady_clock;
+
+                static constexpr std::chrono::milliseconds kDefaultTimeout{60000};
+
+                explicit Poll(std::chrono::milliseconds timeout = kDefaultTimeout);
+                ~Poll();
 
                 Poll(const Poll &) = delete;
                 Poll(Poll &&) = delete;
@@ -42,21 +53,54 @@ namespace pd {
 
                 void run();
 
+                // Handlers may also be added and removed by other handlers while the loop runs
                 void addHandler(HandlerPtr handler) {
-                    m_handlers.insert(std::move(handler));
+                    addHandler(std::move(handler), m_timeout);
                 }
 
-                void removeHandler(HandlerPtr handler) {
-                    m_handlers.erase(handler);
-                }
+                void addHandler(HandlerPtr handler, std::chrono::milliseconds timeout);
+
+                void removeHandler(const HandlerPtr &handler);
 
                 void shutdown() {
                     m_isStopped = true;
                 }
 
+                [[nodiscard]] std::size_t size() const {
+                    return m_entries.size();
+                }
+
             private:
-                std::unordered_set<HandlerPtr> m_handlers;
+                using Id = std::uint64_t;
+
+                struct Entry {
+                    HandlerPtr handler;
+                    // The socket registered for the handler; a handler may move to a new connection
+                    Socket::SocketType socket;
+                    // Events the socket is registered for
+                    short events;
+                    std::chrono::milliseconds timeout;
+                    Clock::time_point deadline;
+                };
+
+                using Entries = std::unordered_map<Id, Entry>;
+
+                void dispatch(Id id, short revents);
+                void remove(Entries::iterator it);
+                void touch(Id id, Entry &entry);
+                void watch(Id id, Entry &entry, bool added);
+                [[nodiscard]] int waitTime() const;
+                void expireTimers();
+
+                std::chrono::milliseconds m_timeout;
+                Entries m_entries;
+                std::unordered_map<const Handler *, Id> m_ids;
+                std::set<std::pair<Clock::time_point, Id>> m_deadlines;
+                Id m_nextId{0};
                 std::atomic_bool m_isStopped{false};
+#ifdef __linux__
+                int m_epoll{-1};
+#endif
             };
         }// namespace httpreader
     }// namespace internal
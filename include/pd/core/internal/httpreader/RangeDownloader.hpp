@@ -0,0 +1,151 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/httpreader/HttpMessage.hpp>
+#include <pd/core/internal/httpreader/HttpReader.hpp>
+#include <pd/core/internal/httpreader/Poll.hpp>
+#include <pd/core/internal/httpreader/UriParser.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+
+            // Downloads the bytes of a file of known size from the offset on as byte ranges fetched over several
+            // connections at once, which a single TCP stream cannot match on fast links. The ranges are downloaded
+            // in rounds of one range per connection, so at most connections * rangeSize bytes are held in memory;
+            // each range is passed to the callback as soon as it and all the ranges before it are complete.
+            // Every range is requested from the version of the file the validators identify (If-Range) and
+            // checked against its Content-Range, so a file changed on the server fails the download instead of
+            // splicing two versions together. THandler is HttpHandler or HttpsHandler.
+            template<typename THandler>
+            class RangeDownloader {
+            public:
+                RangeDownloader(const Uri &uri, std::size_t offset, std::size_t totalSize, std::size_t connections, std::size_t rangeSize,
+                                const CacheValidators &validators, std::chrono::milliseconds timeout = Poll::kDefaultTimeout)
+                    : m_uri{uri}, m_offset{offset}, m_totalSize{totalSize}, m_connections{std::max<std::size_t>(connections, 1)}, m_rangeSize{std::max<std::size_t>(rangeSize, 1)},
+                      m_ifRange{ifRange(validators)}, m_timeout{timeout} {
+                }
+
+                void run(const HttpReader::Callback &callback) {
+                    std::size_t offset = m_offset;
+                    while (offset < m_totalSize) {
+                        std::vector<Range> ranges;
+                        while (ranges.size() < m_connections && offset < m_totalSize) {
+                            std::size_t size = std::min(m_rangeSize, m_totalSize - offset);
+                            ranges.push_back(Range{ByteRange{offset, offset + size - 1, m_ifRange}, size});
+                            offset += size;
+                        }
+                        runRound(ranges, callback);
+                    }
+                }
+
+            private:
+                struct Range {
+                    ByteRange range;
+                    std::size_t size;
+                    std::string data{};
+                    std::shared_ptr<THandler> handler{};
+                };
+
+                // A weak entity tag cannot make a range conditional, a date can
+                static std::string ifRange(const CacheValidators &validators) {
+                    if (!validators.etag.empty() && validators.etag.rfind("W/", 0) != 0) {
+                        return validators.etag;
+                    }
+                    return validators.lastModified;
+                }
+
+                void check(const Range &range, const HttpMessage &response) const {
+                    if (response.m_statusCode != HttpMessage::StatusCodes::kPartialContent) {
+                        if (!m_ifRange.empty() && response.m_statusCode == HttpMessage::StatusCodes::kOk) {
+                            PD_THROW_WITH_STACKTRACE(std::runtime_error, "File changed on the server during the download");
+                        }
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Server ignored the range request");
+                    }
+                    if (!response.m_contentRange || response.m_contentRange->first != range.range.first ||
+                        response.m_contentRange->last != range.range.last || response.m_completeLength != m_totalSize) {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Content-Range does not match the requested range");
+                    }
+                }
+
+                void runRound(std::vector<Range> &ranges, const HttpReader::Callback &callback) {
+                    std::size_t delivered = 0;
+                    auto deliver = [&ranges, &delivered, &callback]() {
+                        while (delivered < ranges.size() && ranges[delivered].data.size() == ranges[delivered].size) {
+                            auto &range = ranges[delivered++];
+                            callback(range.data.data(), range.data.size());
+                            std::string{}.swap(range.data);
+                        }
+                    };
+
+                    Poll poll{m_timeout};
+                    for (std::size_t i = 0; i < ranges.size(); ++i) {
+                        ranges[i].data.reserve(ranges[i].size);
+                        ranges[i].handler = std::make_shared<THandler>(
+                                "pd",
+                                m_uri,
+                                [this, &ranges, &deliver, i](const char *data, std::size_t size) {
+                                    auto &range = ranges[i];
+                                    check(range, *range.handler->response());
+                                    if (range.data.size() + size > range.size) {
+                                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Server sent more than the requested range");
+                                    }
+                                    range.data.append(data, size);
+                                    if (range.data.size() == range.size) {
+                                        deliver();
+                                    }
+                                },
+                                [](const std::string &) {
+                                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unexpected redirect of a range request");
+                                },
+                                HttpMessage::Method::kGet,
+                                ranges[i].range);
+                        poll.addHandler(ranges[i].handler);
+                    }
+                    poll.run();
+
+                    if (delivered != ranges.size()) {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Incomplete range download");
+                    }
+                }
+
+                Uri m_uri;
+                std::size_t m_offset;
+                std::size_t m_totalSize;
+                std::size_t m_connections;
+                std::size_t m_rangeSize;
+                std::string m_ifRange;
+                std::chrono::milliseconds m_timeout;
+            };
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,92 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+
+            // Process-wide store of large read buffers. A reader borrows a slab for one read, the stream
+            // fills it (decrypting TLS records straight into it) and the received data is passed on as
+            // pointers into the slab, so a download of any size allocates only a few slabs in total.
+            class ReadBufferPool {
+            public:
+                static const constexpr std::size_t kSlabSize = 256 * 1024;
+
+                // A slab borrowed from the pool, returned on destruction
+                class Slab {
+                public:
+                    Slab(Slab &&another) noexcept = default;
+                    Slab &operator=(Slab &&another) = delete;
+
+                    ~Slab() {
+                        if (m_data) {
+                            m_pool->release(std::move(m_data));
+                        }
+                    }
+
+                    [[nodiscard]] char *data() const {
+                        return m_data.get();
+                    }
+
+                    [[nodiscard]] std::size_t size() const {
+                        return kSlabSize;
+                    }
+
+                private:
+                    friend class ReadBufferPool;
+
+                    Slab(ReadBufferPool *pool, std::unique_ptr<char[]> data)
+                        : m_pool{pool}, m_data{std::move(data)} {
+                    }
+
+                    ReadBufferPool *m_pool;
+                    std::unique_ptr<char[]> m_data;
+                };
+
+                static ReadBufferPool &instance();
+
+                ReadBufferPool(const ReadBufferPool &) = delete;
+                ReadBufferPool &operator=(const ReadBufferPool &) = delete;
+
+                Slab acquire();
+
+            private:
+                ReadBufferPool() = default;
+
+                void release(std::unique_ptr<char[]> data);
+
+                // Slabs beyond this many are freed on release
+                static const constexpr std::size_t kMaxFreeSlabs = 16;
+
+                std::mutex m_mutex;
+                std::vector<std::unique_ptr<char[]>> m_free;
+            };
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
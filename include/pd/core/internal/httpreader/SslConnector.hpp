@@ -28,7 +28,11 @@ SOFTWARE.
 namespace pd {
     namespace internal {
         namespace httpreader {
+            // Performs the TLS handshake, resuming the last session saved for the address if there is one
             void sslConnect(const SslStreamPtr &stream, const Address &address);
+
+            // Remembers the session of the connection for later handshakes with the same address
+            void saveSslSession(const SslStreamPtr &stream, const Address &address);
         }// namespace httpreader
     }// namespace internal
 }// namespace pd
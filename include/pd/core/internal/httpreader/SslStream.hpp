@@ -23,6 +23,8 @@ SOFTWARE.
 #pragma once
 
 #ifdef OPENSSL
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <openssl/ssl.h>
 
@@ -31,16 +33,38 @@ SOFTWARE.
 namespace pd {
     namespace internal {
         namespace httpreader {
+            // Totals of all TLS reads of the process
+            struct TlsReadStatistics {
+                // Decrypted bytes
+                std::uint64_t bytes{0};
+                // SSL_read calls
+                std::uint64_t calls{0};
+                // Time spent in SSL_read: receiving and decrypting
+                std::chrono::nanoseconds time{0};
+
+                // Decrypted bytes per second of SSL_read time
+                [[nodiscard]] double throughput() const {
+                    return time.count() == 0 ? 0.0 : static_cast<double>(bytes) * 1e9 / static_cast<double>(time.count());
+                }
+            };
+
             class SslStream : public Stream {
             public:
                 SslStream() = default;
-                ~SslStream() = default;
+                ~SslStream() override {
+                    SslStream::close();
+                }
 
                 void setHost(const std::string &host);
+                // Offers a session of an earlier connection to the same host for an abbreviated handshake
+                void setSession(SSL_SESSION *session);
+                // Returns the current session with an added reference or nullptr if it cannot be resumed
+                [[nodiscard]] SSL_SESSION *getSession() const;
                 void connect();
                 void open() override;
                 void close() override;
 
+                // Decrypts as many records as the socket has ready and the buffer can take whole
                 std::size_t read(void *buffer, std::size_t count) const override;
                 std::size_t write(const void *buffer, std::size_t count) const override;
 
@@ -48,8 +72,13 @@ namespace pd {
                     SSL_shutdown(m_ssl);
                 }
 
+                [[nodiscard]] static TlsReadStatistics readStatistics();
+                static void resetReadStatistics();
+
             private:
-                SSL_CTX *m_ctx{nullptr};
+                // Whether the socket has data to receive right now
+                [[nodiscard]] bool isReadable() const;
+
                 SSL *m_ssl{nullptr};
             };
 
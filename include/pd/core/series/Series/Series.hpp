@@ -22,12 +22,37 @@ SOFTWARE.
 
 #pragma once
 
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
 #include <pd/Exception.hpp>
 #include <pd/core/internal/Array.hpp>
+#include <pd/core/internal/HyperLogLog.hpp>
 #include <pd/core/internal/Index.hpp>
+#include <pd/core/internal/SpaceSaving.hpp>
+#include <pd/core/internal/TDigest.hpp>
 #include <pd/core/internal/Value.hpp>
+#include <pd/core/window/Expanding/Expanding.hpp>
+#include <pd/core/window/Rolling/Rolling.hpp>
 
 namespace pd {
+    enum class QuantileMethod {
+        // Selection on a copy of the data, linear interpolation between the closest ranks
+        kExact,
+        // t-digest: bounded memory, computed in parallel and mergeable across chunks
+        kApproximate
+    };
+
+    enum class Summation {
+        // Several independent accumulators: fastest, the error grows linearly with the size
+        kFast,
+        // Pairwise summation of the products: the error grows with the logarithm of the size
+        kPairwise,
+        // Compensated (Kahan-Babuska) summation: the error does not grow with the size
+        kCompensated
+    };
+
     class Series {
     public:
         Series() = default;
@@ -50,11 +75,12 @@ namespace pd {
             : Series{internal::Array{data.copy()}, index, name} {
         }
 
+        // Takes over the buffer of a dynamic array, other arrays are copied
         template<typename DType, typename Derived, typename Storage>
         explicit Series(np::ndarray::internal::NDArrayBase<DType, Derived, Storage> &&data,
                         const std::vector<internal::Value> &index = std::vector<internal::Value>{},
                         const internal::Value &name = internal::Value{})
-            : Series{internal::Array{data.copy()}, index, name} {
+            : Series{toArray(std::move(data)), index, name} {
         }
 
         Series(const internal::Array &data, const std::vector<internal::Value> &index)
@@ -68,7 +94,7 @@ namespace pd {
 
         template<typename DType, typename Derived, typename Storage>
         Series(np::ndarray::internal::NDArrayBase<DType, Derived, Storage> &&data, const std::vector<internal::Value> &index)
-            : Series{data, index, internal::Value{}} {
+            : Series{std::move(data), index, internal::Value{}} {
         }
 
         Series(const internal::Array &data, const internal::Value &name)
@@ -76,7 +102,7 @@ namespace pd {
         }
 
         Series(internal::Array &&data, const internal::Value &name)
-            : Series{data, std::vector<internal::Value>{}, name} {
+            : Series{std::move(data), std::vector<internal::Value>{}, name} {
         }
 
         template<typename DType, typename Derived, typename Storage>
@@ -86,11 +112,11 @@ namespace pd {
 
         template<typename DType, typename Derived, typename Storage>
         Series(np::ndarray::internal::NDArrayBase<DType, Derived, Storage> &&data, const internal::Value &name)
-            : Series{data, std::vector<internal::Value>{}, name} {
+            : Series{std::move(data), std::vector<internal::Value>{}, name} {
         }
 
         Series(const np::Shape &shape, const internal::Value &columnName)
-            : m_name{columnName}, m_shape{shape}, m_size{shape.calcSizeByShape()} {
+            : m_index{shape.calcSizeByShape()}, m_name{columnName}, m_shape{shape}, m_size{shape.calcSizeByShape()} {
         }
 
         Series &operator=(const Series &) = default;
@@ -123,9 +149,64 @@ namespace pd {
         [[nodiscard]] np::float_ std_(bool skipna = true) const;
         [[nodiscard]] np::float_ var(bool skipna = true) const;
 
+        // count, mean, std, min and max of a numeric series, computed in a single pass
+        [[nodiscard]] Series describe() const;
+
+        [[nodiscard]] np::float_ quantile(np::float_ q = 0.5, QuantileMethod method = QuantileMethod::kExact) const;
+        // Several quantiles at once: the exact method partitions the data once for all of them
+        [[nodiscard]] Series quantile(const std::vector<np::float_> &q, QuantileMethod method = QuantileMethod::kExact) const;
+        [[nodiscard]] np::float_ median(QuantileMethod method = QuantileMethod::kExact) const;
+
+        // t-digest of the numeric values; digests of several series can be merged before querying quantiles
+        [[nodiscard]] internal::TDigest tdigest(np::float_ compression = 100.0) const;
+
+        // Windows of the given size; by default a window needs all of its values to be non-NaN
+        [[nodiscard]] Rolling<Series> rolling(np::Size window) const;
+        [[nodiscard]] Rolling<Series> rolling(np::Size window, np::Size minPeriods) const;
+        [[nodiscard]] Expanding<Series> expanding(np::Size minPeriods = 1) const;
+
+        // Cumulative scans, NaNs are skipped
+        [[nodiscard]] Series cumsum() const;
+        [[nodiscard]] Series cumprod() const;
+        [[nodiscard]] Series cummin() const;
+        [[nodiscard]] Series cummax() const;
+
+        // Difference with the element periods rows before, float64
+        [[nodiscard]] Series diff(np::int_ periods = 1) const;
+        // Values moved down by periods rows (up for negative periods), float64 with NaN in the vacated rows
+        [[nodiscard]] Series shift(np::int_ periods = 1) const;
+
+        // Rows at the given positions
+        [[nodiscard]] Series take(const std::vector<np::Size> &rows) const;
+
+        // Number of rows of every distinct value, most frequent first
+        [[nodiscard]] Series value_counts(bool dropna = true) const;
+        // Distinct values in order of appearance
+        [[nodiscard]] Series unique() const;
+        [[nodiscard]] np::Size nunique(bool dropna = true) const;
+
+        // Approximate number of distinct non-NaN values in bounded memory (HyperLogLog, 2^precision registers)
+        [[nodiscard]] np::Size approx_nunique(np::Size precision = 14) const;
+        // The sketch itself: sketches of several chunks can be merged before estimating
+        [[nodiscard]] internal::HyperLogLog hyperloglog(np::Size precision = 14) const;
+
+        // Approximate k most frequent values with their estimated counts, most frequent first.
+        // Space-Saving with capacity counters, 10 * k by default.
+        [[nodiscard]] Series approx_top_k(np::Size k, np::Size capacity = 0) const;
+        // The sketch itself: sketches of several chunks can be merged before querying
+        [[nodiscard]] internal::SpaceSaving<internal::Value> space_saving(np::Size capacity) const;
+
         [[nodiscard]] Series replace(internal::Value to_replace, internal::Value value) const;
+        // Replaces every value found among the keys in a single pass; the dtype is kept when the new values fit it
+        [[nodiscard]] Series replace(const std::unordered_map<internal::Value, internal::Value> &to_replace) const;
+        // Maps every value through the dict in a single pass, values without a key become NaN
+        [[nodiscard]] Series map(const std::unordered_map<internal::Value, internal::Value> &mapping) const;
+        // Mask of the rows equal to one of values, to be passed to iloc
+        [[nodiscard]] std::vector<bool> isin(const std::vector<internal::Value> &values) const;
 
-        [[nodiscard]] internal::Value dot(const Series &another) const;
+        // Typed kernels: integer series of the same dtype give an exact integer result, other numeric series are
+        // multiplied as float64 in blocks, split across threads, and summed as requested
+        [[nodiscard]] internal::Value dot(const Series &another, Summation summation = Summation::kFast) const;
 
         void info() const;
 
@@ -186,6 +267,15 @@ namespace pd {
         }
 
     private:
+        template<typename DType, typename Derived, typename Storage>
+        static internal::Array toArray(np::ndarray::internal::NDArrayBase<DType, Derived, Storage> &&data) {
+            if constexpr (std::is_same_v<Derived, np::Array<DType>>) {
+                return internal::Array{std::move(static_cast<Derived &>(data))};
+            } else {
+                return internal::Array{data.copy()};
+            }
+        }
+
         Series slicing1(const std::string &cond) const;
         Series callable1(const std::string &cond) const;
 
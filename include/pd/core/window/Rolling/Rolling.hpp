@@ -0,0 +1,50 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <np/Array.hpp>
+
+namespace pd {
+    // Rolling window calculations over a Series or a DataFrame, e.g. series.rolling(7).mean().
+    // Every aggregation is O(n) regardless of the window size; DataFrame columns are processed in parallel.
+    // The result has NaN where the window holds fewer than minPeriods non-NaN values.
+    // The result keeps the row labels of the object.
+    template<typename Object>
+    class Rolling {
+    public:
+        Rolling(const Object &object, np::Size window, np::Size minPeriods);
+
+        [[nodiscard]] Object sum() const;
+        [[nodiscard]] Object mean() const;
+        [[nodiscard]] Object var(np::Size ddof = 1) const;
+        [[nodiscard]] Object std_(np::Size ddof = 1) const;
+        [[nodiscard]] Object min() const;
+        [[nodiscard]] Object max() const;
+
+    private:
+        // Held by value: a rolling object may outlive the expression that created it
+        Object m_object;
+        np::Size m_window;
+        np::Size m_minPeriods;
+    };
+}// namespace pd
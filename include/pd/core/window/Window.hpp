@@ -0,0 +1,54 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <np/Array.hpp>
+#include <pd/core/frame/DataFrame/DataFrame.hpp>
+#include <pd/core/internal/Array.hpp>
+#include <pd/core/series/Series/Series.hpp>
+
+namespace pd {
+    namespace internal {
+        enum class WindowFunction {
+            kSum,
+            kMean,
+            kVar,
+            kStd,
+            kMin,
+            kMax
+        };
+
+        // Aggregates every window of a numeric array in O(n): sum, mean and var are updated as values enter
+        // and leave the window, min and max keep a monotonic deque of candidate positions.
+        // window == 0 means an expanding window. NaNs are skipped; windows with fewer than minPeriods
+        // values produce NaN.
+        [[nodiscard]] np::Array<np::float_> aggregateWindow(const Array &data, np::Size window, np::Size minPeriods,
+                                                            WindowFunction function, np::Size ddof);
+
+        [[nodiscard]] Series aggregateWindow(const Series &series, np::Size window, np::Size minPeriods,
+                                             WindowFunction function, np::Size ddof);
+        // Columns are aggregated in parallel
+        [[nodiscard]] DataFrame aggregateWindow(const DataFrame &dataFrame, np::Size window, np::Size minPeriods,
+                                                WindowFunction function, np::Size ddof);
+    }// namespace internal
+}// namespace pd
@@ -22,6 +22,12 @@ SOFTWARE.
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <string>
+#include <vector>
+
 #include <pd/core/frame/DataFrame/DataFrame.hpp>
 
 namespace pd {
@@ -38,7 +44,27 @@ namespace pd {
     struct ReadCsvSettings {
         Header header{Header::kInfer};
         Separator separator{Separator::kComma};
+        // http(s) files larger than rangeSize that the server sends uncompressed are downloaded in byte ranges
+        // over this many parallel connections. Compressed files come whole over one connection.
+        // read_csv_many ignores connections, rangeSize and cacheDirectory.
+        std::size_t connections{4};
+        std::size_t rangeSize{8 * 1024 * 1024};
+        // A download fails when its connection has no activity for this long
+        std::chrono::milliseconds timeout{60000};
+        // When not empty, http(s) files are stored in this directory and later downloads send the stored validators:
+        // a 304 Not Modified response is served from the directory instead of downloading the file again
+        std::string cacheDirectory;
     };
 
     pd::DataFrame read_csv(const std::string &filepath, const ReadCsvSettings &settings = ReadCsvSettings{});
+
+    // Reads the file without blocking the calling thread. Reading and parsing run on two threads of their own
+    // connected by a bounded buffer, so the file is parsed while it is still being downloaded.
+    std::future<pd::DataFrame> read_csv_async(const std::string &filepath, const ReadCsvSettings &settings = ReadCsvSettings{});
+
+    // Reads many local files and http(s) urls at once: downloads share one event loop and parsing runs
+    // on a pool of worker threads. Returns one frame per path, in the order of the paths.
+    // Every url is downloaded whole over one connection: connections, rangeSize and cacheDirectory
+    // of the settings do not apply here.
+    std::vector<pd::DataFrame> read_csv_many(const std::vector<std::string> &paths, const ReadCsvSettings &settings = ReadCsvSettings{});
 }// namespace pd
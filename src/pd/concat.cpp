@@ -0,0 +1,240 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+
+#include <pd/Exception.hpp>
+#include <pd/concat.hpp>
+#include <pd/core/internal/Parallel.hpp>
+
+namespace pd {
+    enum class ColumnType {
+        kBool,
+        kIntC,
+        kInt,
+        kSize,
+        kFloat,
+        kString,
+        kUnicode,
+        kValue
+    };
+
+    static ColumnType columnType(const internal::Array &data) {
+        if (data.isBoolArray()) {
+            return ColumnType::kBool;
+        } else if (data.isIntCArray()) {
+            return ColumnType::kIntC;
+        } else if (data.isIntArray()) {
+            return ColumnType::kInt;
+        } else if (data.isSizeArray()) {
+            return ColumnType::kSize;
+        } else if (data.isFloatArray()) {
+            return ColumnType::kFloat;
+        } else if (data.isStringArray()) {
+            return ColumnType::kString;
+        } else if (data.isUnicodeArray()) {
+            return ColumnType::kUnicode;
+        }
+        return ColumnType::kValue;
+    }
+
+    static bool isInteger(ColumnType type) {
+        return type == ColumnType::kIntC || type == ColumnType::kInt || type == ColumnType::kSize;
+    }
+
+    static ColumnType commonType(ColumnType type1, ColumnType type2) {
+        if (type1 == type2) {
+            return type1;
+        }
+        if (isInteger(type1) && isInteger(type2)) {
+            return ColumnType::kInt;
+        }
+        if ((isInteger(type1) || type1 == ColumnType::kFloat) && (isInteger(type2) || type2 == ColumnType::kFloat)) {
+            return ColumnType::kFloat;
+        }
+        return ColumnType::kValue;
+    }
+
+    // Type of a column that is missing from some frames and is filled with NaN there
+    static ColumnType withMissing(ColumnType type) {
+        if (isInteger(type) || type == ColumnType::kFloat) {
+            return ColumnType::kFloat;
+        }
+        return ColumnType::kValue;
+    }
+
+    template<typename Out, typename In>
+    static void copy(const np::Array<In> &source, np::Size offset, np::Array<Out> &result) {
+        for (np::Size i = 0; i < source.size(); ++i) {
+            if constexpr (std::is_same_v<Out, In>) {
+                result.set(offset + i, source.get(i));
+            } else if constexpr (std::is_same_v<Out, internal::Value>) {
+                result.set(offset + i, internal::Value{source.get(i)});
+            } else if constexpr (std::is_arithmetic_v<Out> && std::is_arithmetic_v<In>) {
+                result.set(offset + i, static_cast<Out>(source.get(i)));
+            } else {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Incompatible column types");
+            }
+        }
+    }
+
+    template<typename Out>
+    static void copy(const internal::Array &source, np::Size offset, np::Array<Out> &result) {
+        if (source.isBoolArray()) {
+            copy(*static_cast<const np::Array<np::bool_> *>(source), offset, result);
+        } else if (source.isIntCArray()) {
+            copy(*static_cast<const np::Array<np::intc> *>(source), offset, result);
+        } else if (source.isIntArray()) {
+            copy(*static_cast<const np::Array<np::int_> *>(source), offset, result);
+        } else if (source.isSizeArray()) {
+            copy(*static_cast<const np::Array<np::Size> *>(source), offset, result);
+        } else if (source.isFloatArray()) {
+            copy(*static_cast<const np::Array<np::float_> *>(source), offset, result);
+        } else if (source.isStringArray()) {
+            copy(*static_cast<const np::Array<np::string_> *>(source), offset, result);
+        } else if (source.isUnicodeArray()) {
+            copy(*static_cast<const np::Array<np::unicode_> *>(source), offset, result);
+        } else if (source.isValueArray()) {
+            copy(*static_cast<const np::Array<internal::Value> *>(source), offset, result);
+        } else {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
+        }
+    }
+
+    // Parts of an output column: the column of every frame, nullptr where the frame does not have it
+    template<typename Out>
+    static internal::Array stack(const std::vector<const internal::Array *> &parts, const std::vector<np::Size> &sizes, np::Size total) {
+        np::Array<Out> result{np::Shape{total}};
+        np::Size offset = 0;
+        for (np::Size i = 0; i < parts.size(); ++i) {
+            if (parts[i] != nullptr) {
+                copy(*parts[i], offset, result);
+            } else {
+                if constexpr (std::is_same_v<Out, np::float_> || std::is_same_v<Out, internal::Value>) {
+                    auto nan = Out{std::numeric_limits<np::float_>::quiet_NaN()};
+                    for (np::Size row = offset; row < offset + sizes[i]; ++row) {
+                        result.set(row, nan);
+                    }
+                } else {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Missing values need a float or value column");
+                }
+            }
+            offset += sizes[i];
+        }
+        return internal::Array{std::move(result)};
+    }
+
+    static internal::Array stack(ColumnType type, const std::vector<const internal::Array *> &parts, const std::vector<np::Size> &sizes, np::Size total) {
+        switch (type) {
+            case ColumnType::kBool:
+                return stack<np::bool_>(parts, sizes, total);
+            case ColumnType::kIntC:
+                return stack<np::intc>(parts, sizes, total);
+            case ColumnType::kInt:
+                return stack<np::int_>(parts, sizes, total);
+            case ColumnType::kSize:
+                return stack<np::Size>(parts, sizes, total);
+            case ColumnType::kFloat:
+                return stack<np::float_>(parts, sizes, total);
+            case ColumnType::kString:
+                return stack<np::string_>(parts, sizes, total);
+            case ColumnType::kUnicode:
+                return stack<np::unicode_>(parts, sizes, total);
+            case ColumnType::kValue:
+                return stack<internal::Value>(parts, sizes, total);
+        }
+        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
+    }
+
+    static DataFrame concatRows(const std::vector<DataFrame> &frames) {
+        std::vector<internal::Value> names;
+        std::unordered_map<internal::Value, np::Size> positions;
+        std::vector<np::Size> sizes;
+        np::Size total = 0;
+        for (const auto &frame: frames) {
+            auto rows = frame.empty() ? np::Size{0} : frame.shape()[0];
+            sizes.push_back(rows);
+            total += rows;
+            for (const auto &name: frame.columns().getIndex()) {
+                if (positions.emplace(name, names.size()).second) {
+                    names.push_back(name);
+                }
+            }
+        }
+
+        // Schema first: the parts and the common type of every output column
+        std::vector<std::vector<const internal::Array *>> parts(names.size(), std::vector<const internal::Array *>(frames.size(), nullptr));
+        std::vector<ColumnType> types(names.size());
+        for (np::Size column = 0; column < names.size(); ++column) {
+            bool first = true;
+            bool missing = false;
+            for (np::Size i = 0; i < frames.size(); ++i) {
+                if (!frames[i].hasColumn(names[column])) {
+                    missing = missing || sizes[i] > 0;
+                    continue;
+                }
+                const auto &data = frames[i][names[column]].values();
+                parts[column][i] = &data;
+                types[column] = first ? columnType(data) : commonType(types[column], columnType(data));
+                first = false;
+            }
+            if (missing) {
+                types[column] = withMissing(types[column]);
+            }
+        }
+
+        std::vector<internal::Array> columns(names.size());
+        internal::parallelFor(static_cast<np::Size>(names.size()), 1, [&](np::Size, np::Size begin, np::Size end) {
+            for (auto column = begin; column < end; ++column) {
+                columns[column] = stack(types[column], parts[column], sizes, total);
+            }
+        });
+
+        DataFrame result;
+        for (np::Size column = 0; column < names.size(); ++column) {
+            result.append(Series{std::move(columns[column]), names[column]});
+        }
+        return result;
+    }
+
+    static DataFrame concatColumns(std::vector<DataFrame> &frames) {
+        DataFrame result;
+        for (auto &frame: frames) {
+            for (const auto &name: frame.columns().getIndex()) {
+                if (result.hasColumn(name)) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Duplicate column");
+                }
+                result.append(std::move(frame[name]));
+            }
+        }
+        return result;
+    }
+
+    DataFrame concat(std::vector<DataFrame> frames, Axis axis) {
+        if (axis == Axis::kColumns) {
+            return concatColumns(frames);
+        }
+        return concatRows(frames);
+    }
+}// namespace pd
@@ -20,9 +20,19 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <unordered_map>
+
 #include <pd/Exception.hpp>
 #include <pd/core/frame/DataFrame/DataFrame.hpp>
+#include <pd/core/internal/Expression.hpp>
+#include <pd/core/internal/Factorize.hpp>
 #include <pd/core/internal/Indexing.hpp>
+#include <pd/core/internal/LinearAlgebra.hpp>
+#include <pd/core/internal/Parallel.hpp>
+#include <pd/core/internal/Reduction.hpp>
 
 namespace pd {
     DataFrame::DataFrame()
@@ -54,26 +64,38 @@ namespace pd {
     }
 
     void DataFrame::append(const DataFrame &df) {
+        append(DataFrame{df});
+    }
+
+    void DataFrame::append(DataFrame &&df) {
         if (!empty() && m_shape[0] != df.shape()[0]) {
             PD_THROW_WITH_STACKTRACE(std::runtime_error, "Added dataframe has different number of rows from existing dataframe");
         }
 
+        // A frame with a single column is one-dimensional, so the column count is taken from the labels
+        auto columns = df.m_columns.size();
         if (empty()) {
-            m_shape.addDim(df.shape()[0]);
+            m_shape = df.m_shape;
         } else if (ndim() == 1) {
-            m_shape.addDim(df.shape()[1] + 1);
+            m_shape.addDim(columns + 1);
         } else {
-            m_shape[1] += df.shape()[1];
+            m_shape[1] += columns;
         }
 
         for (const auto &column: df.columns().getIndex()) {
-            m_columnData.emplace(column, df[column]);
+            m_columnData.emplace(column, std::move(df[column]));
         }
         m_columns.addIndex(df.m_columns);
-        m_index.addIndex(df.m_index);
+        if (m_index.empty()) {
+            m_index = std::move(df.m_index);
+        }
     }
 
     void DataFrame::append(const Series &series) {
+        append(Series{series});
+    }
+
+    void DataFrame::append(Series &&series) {
         if (!empty() && m_shape[0] != series.shape()[0]) {
             PD_THROW_WITH_STACKTRACE(std::runtime_error, "Added series has different number of rows from existing dataframe");
         }
@@ -86,11 +108,13 @@ namespace pd {
             ++m_shape[1];
         }
 
-        m_columnData.emplace(series.name(), series);
-        m_columns.addIndex(series.name());
+        auto name = series.name();
         if (m_index.empty()) {
-            m_index.addIndex(internal::Index{series.shape()[0]});
+            // The first column gives its row labels to the frame
+            m_index = series.index();
         }
+        m_columnData.emplace(name, std::move(series));
+        m_columns.addIndex(name);
     }
 
     const Series &DataFrame::operator[](const internal::Value &column) const {
@@ -120,31 +144,31 @@ namespace pd {
             if (value.isBool()) {
                 np::Array<np::bool_> array{np::Shape{1}};
                 array.set(0, *static_cast<const np::bool_ *>(value));
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isInt()) {
                 np::Array<np::int_> array{np::Shape{1}};
                 array.set(0, *static_cast<const np::int_ *>(value));
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isIntC()) {
                 np::Array<np::intc> array{np::Shape{1}};
                 array.set(0, *static_cast<const np::intc *>(value));
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isSize()) {
                 np::Array<np::Size> array{np::Shape{1}};
                 array.set(0, *static_cast<const np::Size *>(value));
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isFloat()) {
                 np::Array<np::float_> array{np::Shape{1}};
                 array.set(0, *static_cast<const np::float_ *>(value));
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isString()) {
                 np::Array<np::string_> array{np::Shape{1}};
                 array.set(0, *static_cast<const np::string_ *>(value));
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isUnicode()) {
                 np::Array<np::unicode_> array{np::Shape{1}};
                 array.set(0, *static_cast<const np::unicode_ *>(value));
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
             }
@@ -199,49 +223,49 @@ namespace pd {
                     auto cell = static_cast<np::bool_>(at(i + firstIndex, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isInt()) {
                 np::Array<np::int_> array{np::Shape{lastIndex - firstIndex}};
                 for (np::Size i = 0; i < lastIndex - firstIndex; ++i) {
                     auto cell = static_cast<np::int_>(at(i + firstIndex, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isIntC()) {
                 np::Array<np::intc> array{np::Shape{lastIndex - firstIndex}};
                 for (np::Size i = 0; i < lastIndex - firstIndex; ++i) {
                     auto cell = static_cast<np::intc>(at(i + firstIndex, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isFloat()) {
                 np::Array<np::float_> array{np::Shape{lastIndex - firstIndex}};
                 for (np::Size i = 0; i < lastIndex - firstIndex; ++i) {
                     auto cell = static_cast<np::float_>(at(i + firstIndex, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isString()) {
                 np::Array<np::string_> array{np::Shape{lastIndex - firstIndex}};
                 for (np::Size i = 0; i < lastIndex - firstIndex; ++i) {
                     auto cell = static_cast<np::string_>(at(i + firstIndex, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isUnicode()) {
                 np::Array<np::unicode_> array{np::Shape{lastIndex - firstIndex}};
                 for (np::Size i = 0; i < lastIndex - firstIndex; ++i) {
                     auto cell = static_cast<np::unicode_>(at(i + firstIndex, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isSize()) {
                 np::Array<np::Size> array{np::Shape{lastIndex - firstIndex}};
                 for (np::Size i = 0; i < lastIndex - firstIndex; ++i) {
                     auto cell = static_cast<np::Size>(at(i + firstIndex, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
             }
@@ -302,23 +326,23 @@ namespace pd {
                 if (value.isBool()) {
                     np::Array<np::bool_> array{np::Shape{1}};
                     array.set(0, *static_cast<const np::int_ *>(value));
-                    dataFrame.append(Series{array, columnName});
+                    dataFrame.append(Series{std::move(array), columnName});
                 } else if (value.isInt()) {
                     np::Array<np::int_> array{np::Shape{1}};
                     array.set(0, *static_cast<const np::int_ *>(value));
-                    dataFrame.append(Series{array, columnName});
+                    dataFrame.append(Series{std::move(array), columnName});
                 } else if (value.isFloat()) {
                     np::Array<np::float_> array{np::Shape{1}};
                     array.set(0, *static_cast<const np::float_ *>(value));
-                    dataFrame.append(Series{array, columnName});
+                    dataFrame.append(Series{std::move(array), columnName});
                 } else if (value.isString()) {
                     np::Array<np::string_> array{np::Shape{1}};
                     array.set(0, *static_cast<const np::string_ *>(value));
-                    dataFrame.append(Series{array, columnName});
+                    dataFrame.append(Series{std::move(array), columnName});
                 } else if (value.isUnicode()) {
                     np::Array<np::unicode_> array{np::Shape{1}};
                     array.set(0, *static_cast<const np::unicode_ *>(value));
-                    dataFrame.append(Series{array, columnName});
+                    dataFrame.append(Series{std::move(array), columnName});
                 } else {
                     PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
                 }
@@ -402,49 +426,49 @@ namespace pd {
                     auto cell = static_cast<np::bool_>(at(rowsFirstIndex + i, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isInt()) {
                 np::Array<np::int_> array{np::Shape{rowsLastIndex - rowsFirstIndex}};
                 for (np::Size i = 0; i < rowsLastIndex - rowsFirstIndex; ++i) {
                     auto cell = static_cast<np::int_>(at(rowsFirstIndex + i, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isIntC()) {
                 np::Array<np::intc> array{np::Shape{rowsLastIndex - rowsFirstIndex}};
                 for (np::Size i = 0; i < rowsLastIndex - rowsFirstIndex; ++i) {
                     auto cell = static_cast<np::intc>(at(rowsFirstIndex + i, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isFloat()) {
                 np::Array<np::float_> array{np::Shape{rowsLastIndex - rowsFirstIndex}};
                 for (np::Size i = 0; i < rowsLastIndex - rowsFirstIndex; ++i) {
                     auto cell = static_cast<np::float_>(at(rowsFirstIndex + i, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isString()) {
                 np::Array<np::string_> array{np::Shape{rowsLastIndex - rowsFirstIndex}};
                 for (np::Size i = 0; i < rowsLastIndex - rowsFirstIndex; ++i) {
                     auto cell = static_cast<np::string_>(at(rowsFirstIndex + i, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isUnicode()) {
                 np::Array<np::unicode_> array{np::Shape{rowsLastIndex - rowsFirstIndex}};
                 for (np::Size i = 0; i < rowsLastIndex - rowsFirstIndex; ++i) {
                     auto cell = static_cast<np::unicode_>(at(rowsFirstIndex + i, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else if (value.isSize()) {
                 np::Array<np::Size> array{np::Shape{rowsLastIndex - rowsFirstIndex}};
                 for (np::Size i = 0; i < rowsLastIndex - rowsFirstIndex; ++i) {
                     auto cell = static_cast<np::Size>(at(rowsFirstIndex + i, columnName));
                     array.set(i, cell);
                 }
-                dataFrame.append(Series{array, columnName});
+                dataFrame.append(Series{std::move(array), columnName});
             } else {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
             }
@@ -484,7 +508,7 @@ namespace pd {
                     auto value = static_cast<np::bool_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{std::to_string(row)}};
+                return Series{std::move(array), internal::Value{std::to_string(row)}};
             }
             if (dtype == "float64") {
                 np::Array<np::float_> array{np::Shape{m_columns.size()}};
@@ -493,7 +517,7 @@ namespace pd {
                     auto value = static_cast<np::float_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{std::to_string(row)}};
+                return Series{std::move(array), internal::Value{std::to_string(row)}};
             }
             if (dtype == "int64") {
                 np::Array<np::int_> array{np::Shape{m_columns.size()}};
@@ -502,7 +526,7 @@ namespace pd {
                     auto value = static_cast<np::int_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{std::to_string(row)}};
+                return Series{std::move(array), internal::Value{std::to_string(row)}};
             }
             if (dtype == "int32") {
                 np::Array<np::intc> array{np::Shape{m_columns.size()}};
@@ -511,7 +535,7 @@ namespace pd {
                     auto value = static_cast<np::intc>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{std::to_string(row)}};
+                return Series{std::move(array), internal::Value{std::to_string(row)}};
             }
             if (dtype == "uint64") {
                 np::Array<np::Size> array{np::Shape{m_columns.size()}};
@@ -520,7 +544,7 @@ namespace pd {
                     auto value = static_cast<np::Size>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{std::to_string(row)}};
+                return Series{std::move(array), internal::Value{std::to_string(row)}};
             }
             if (dtype == "str") {
                 np::Array<np::string_> array{np::Shape{m_columns.size()}};
@@ -529,7 +553,7 @@ namespace pd {
                     auto value = static_cast<np::string_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{std::to_string(row)}};
+                return Series{std::move(array), internal::Value{std::to_string(row)}};
             }
             if (dtype == "unicode") {
                 np::Array<np::unicode_> array{np::Shape{m_columns.size()}};
@@ -538,7 +562,7 @@ namespace pd {
                     auto value = static_cast<np::unicode_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{std::to_string(row)}};
+                return Series{std::move(array), internal::Value{std::to_string(row)}};
             }
             PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid value type");
         } else {
@@ -607,7 +631,7 @@ namespace pd {
                     auto value = static_cast<np::float_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value(static_cast<np::int_>(row))};
+                return Series{std::move(array), internal::Value(static_cast<np::int_>(row))};
             }
             if (dtype == "int32") {
                 np::Array<np::intc> array{np::Shape{m_columns.size()}};
@@ -616,7 +640,7 @@ namespace pd {
                     auto value = static_cast<np::intc>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{static_cast<np::int_>(row)}};
+                return Series{std::move(array), internal::Value{static_cast<np::int_>(row)}};
             }
             if (dtype == "int64") {
                 np::Array<np::int_> array{np::Shape{m_columns.size()}};
@@ -625,7 +649,7 @@ namespace pd {
                     auto value = static_cast<np::int_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{static_cast<np::int_>(row)}};
+                return Series{std::move(array), internal::Value{static_cast<np::int_>(row)}};
             }
             if (dtype == "uint64") {
                 np::Array<np::Size> array{np::Shape{m_columns.size()}};
@@ -634,7 +658,7 @@ namespace pd {
                     auto value = static_cast<np::Size>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{static_cast<np::int_>(row)}};
+                return Series{std::move(array), internal::Value{static_cast<np::int_>(row)}};
             }
             if (dtype == "bool") {
                 np::Array<np::bool_> array{np::Shape{m_columns.size()}};
@@ -643,7 +667,7 @@ namespace pd {
                     auto value = static_cast<np::bool_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{static_cast<np::int_>(row)}};
+                return Series{std::move(array), internal::Value{static_cast<np::int_>(row)}};
             }
             if (dtype == "str") {
                 np::Array<np::string_> array{np::Shape{m_columns.size()}};
@@ -652,7 +676,7 @@ namespace pd {
                     auto value = static_cast<np::string_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{static_cast<np::int_>(row)}};
+                return Series{std::move(array), internal::Value{static_cast<np::int_>(row)}};
             }
             if (dtype == "unicode") {
                 np::Array<np::unicode_> array{np::Shape{m_columns.size()}};
@@ -661,7 +685,7 @@ namespace pd {
                     auto value = static_cast<np::unicode_>(at(row, column));
                     array.set(index++, value);
                 }
-                return Series{array, internal::Value{static_cast<np::int_>(row)}};
+                return Series{std::move(array), internal::Value{static_cast<np::int_>(row)}};
             }
             PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid value type");
         }
@@ -750,6 +774,278 @@ namespace pd {
         return Series{columnArray1, 0}.dot(Series{columnArray2, 0});
     }
 
+    Rolling<DataFrame> DataFrame::rolling(np::Size window) const {
+        return Rolling<DataFrame>{*this, window, window};
+    }
+
+    Rolling<DataFrame> DataFrame::rolling(np::Size window, np::Size minPeriods) const {
+        return Rolling<DataFrame>{*this, window, minPeriods};
+    }
+
+    Expanding<DataFrame> DataFrame::expanding(np::Size minPeriods) const {
+        return Expanding<DataFrame>{*this, minPeriods};
+    }
+
+    // Numeric columns of a frame packed into a matrix, with their names
+    static internal::Matrix packNumericColumns(const DataFrame &df, std::vector<internal::Value> &names) {
+        std::vector<const internal::Array *> arrays;
+        for (const auto &columnName: df.columns().getIndex()) {
+            const auto &data = df[columnName].values();
+            if (internal::isNumeric(data)) {
+                arrays.push_back(&data);
+                names.push_back(columnName);
+            }
+        }
+        return internal::packColumns(arrays);
+    }
+
+    static DataFrame squareFrame(const std::vector<np::float_> &values, const std::vector<internal::Value> &names) {
+        if (names.empty()) {
+            return DataFrame{};
+        }
+        auto n = static_cast<np::Size>(names.size());
+        np::Array<np::float_> array{np::Shape{n, n}};
+        for (np::Size i = 0; i < n * n; ++i) {
+            array.set(i, values[i]);
+        }
+        return DataFrame{array, DataFrameParameters{names, names}};
+    }
+
+    Rows DataFrame::itertuples() const {
+        return Rows{*this};
+    }
+
+    RowBatches DataFrame::batches(np::Size batchSize) const {
+        return RowBatches{*this, batchSize};
+    }
+
+    np::Array<np::float_> DataFrame::to_numpy() const {
+        // A single column frame is one-dimensional, so sizes are taken from the labels
+        auto rows = empty() ? np::Size{0} : m_index.size();
+        auto names = m_columns.getIndex();
+        auto columns = static_cast<np::Size>(names.size());
+        std::vector<const internal::Array *> arrays;
+        for (const auto &name: names) {
+            const auto &values = operator[](name).values();
+            if (!internal::isNumeric(values)) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot convert a non-number column to float64");
+            }
+            arrays.push_back(&values);
+        }
+
+        np::Array<np::float_> result{np::Shape{rows, columns}};
+        // Each thread converts its rows a tile at a time: kTransposeTile rows of every column
+        // are loaded into a column-major tile, then written out row by row
+        auto minRows = std::max<np::Size>(kTransposeTile, kMinTransposePerThread / std::max<np::Size>(1, columns));
+        internal::parallelFor(rows, minRows, [&](np::Size, np::Size begin, np::Size end) {
+            std::vector<np::float_> tile(kTransposeTile * columns);
+            for (auto row0 = begin; row0 < end; row0 += kTransposeTile) {
+                auto count = std::min(kTransposeTile, end - row0);
+                for (np::Size column = 0; column < columns; ++column) {
+                    internal::loadBlock(*arrays[column], row0, count, tile.data() + column * kTransposeTile);
+                }
+                for (np::Size i = 0; i < count; ++i) {
+                    for (np::Size column = 0; column < columns; ++column) {
+                        result.set((row0 + i) * columns + column, tile[column * kTransposeTile + i]);
+                    }
+                }
+            }
+        });
+        return result;
+    }
+
+    DataFrame DataFrame::matmul(const DataFrame &another) const {
+        // A single column frame is one-dimensional, so sizes are taken from the labels
+        if (empty() || another.empty() || m_columns.size() != another.m_index.size()) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Shapes are not aligned");
+        }
+        std::vector<internal::Value> names;
+        auto left = packNumericColumns(*this, names);
+        std::vector<internal::Value> otherNames;
+        auto right = packNumericColumns(another, otherNames);
+        if (left.columns != m_columns.size() || right.columns != another.m_columns.size()) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Matrix product of non-numeric columns");
+        }
+        auto product = internal::multiply(left, right);
+
+        DataFrame result;
+        for (np::Size j = 0; j < product.columns; ++j) {
+            np::Array<np::float_> column{np::Shape{product.rows}};
+            const auto *values = product.column(j);
+            for (np::Size i = 0; i < product.rows; ++i) {
+                column.set(i, values[i]);
+            }
+            result.append(Series{std::move(column), otherNames[j]});
+        }
+        // Rows of the product are the rows of the left frame
+        if (!result.empty()) {
+            result.m_index = m_index;
+        }
+        return result;
+    }
+
+    DataFrame DataFrame::corr(CorrelationMethod method, np::Size minPeriods) const {
+        std::vector<internal::Value> names;
+        auto matrix = packNumericColumns(*this, names);
+        if (method == CorrelationMethod::kSpearman) {
+            return squareFrame(internal::rankCorrelation(std::move(matrix), minPeriods), names);
+        }
+        return squareFrame(internal::correlation(std::move(matrix), minPeriods), names);
+    }
+
+    DataFrame DataFrame::cov(np::Size minPeriods, np::Size ddof) const {
+        std::vector<internal::Value> names;
+        auto matrix = packNumericColumns(*this, names);
+        return squareFrame(internal::covariance(std::move(matrix), ddof, minPeriods), names);
+    }
+
+    DataFrame DataFrame::take(const std::vector<np::Size> &rows) const {
+        DataFrame result;
+        for (const auto &columnName: m_columns.getIndex()) {
+            result.append(operator[](columnName).take(rows));
+        }
+        return result;
+    }
+
+    Series DataFrame::duplicated() const {
+        np::Size rows = empty() ? 0 : m_shape[0];
+        auto columns = m_columns.getIndex();
+        std::vector<internal::Factorization> factorizations(columns.size());
+        internal::parallelFor(static_cast<np::Size>(columns.size()), 1, [&](np::Size, np::Size begin, np::Size end) {
+            for (np::Size column = begin; column < end; ++column) {
+                factorizations[column] = internal::factorize(operator[](columns[column]).values());
+            }
+        });
+
+        // Combines the ids of the columns into dense ids of distinct rows, one column at a time
+        std::vector<np::Size> rowCodes(rows, 0);
+        np::Size distinctRows = rows == 0 ? 0 : 1;
+        for (const auto &factorization: factorizations) {
+            auto distinctValues = static_cast<np::Size>(factorization.counts.size());
+            if (distinctValues != 0 && distinctRows > std::numeric_limits<np::Size>::max() / distinctValues) {
+                // The packed pair code would overflow, so the pairs are hashed as they are
+                auto hashPair = [](const std::pair<np::Size, np::Size> &pair) {
+                    return static_cast<std::size_t>(internal::mixHash(internal::mixHash(pair.first) ^ pair.second));
+                };
+                std::unordered_map<std::pair<np::Size, np::Size>, np::Size, decltype(hashPair)> pairs{rows, hashPair};
+                for (np::Size row = 0; row < rows; ++row) {
+                    auto inserted = pairs.try_emplace({rowCodes[row], factorization.codes[row]}, pairs.size());
+                    rowCodes[row] = inserted.first->second;
+                }
+                distinctRows = pairs.size();
+                continue;
+            }
+            internal::HashTable<np::Size> pairs{distinctRows};
+            for (np::Size row = 0; row < rows; ++row) {
+                rowCodes[row] = pairs.insert(rowCodes[row] * distinctValues + factorization.codes[row]).first;
+            }
+            distinctRows = pairs.size();
+        }
+
+        // Row ids are assigned in the order of first appearance
+        np::Array<np::bool_> result{np::Shape{rows}};
+        np::Size nextId = 0;
+        for (np::Size row = 0; row < rows; ++row) {
+            if (rowCodes[row] == nextId) {
+                ++nextId;
+                result.set(row, false);
+            } else {
+                result.set(row, true);
+            }
+        }
+        return Series{std::move(result)};
+    }
+
+    DataFrame DataFrame::drop_duplicates() const {
+        auto duplicates = duplicated();
+        const auto *flags = static_cast<const np::Array<np::bool_> *>(duplicates.values());
+        std::vector<np::Size> rows;
+        for (np::Size row = 0; row < flags->size(); ++row) {
+            if (!flags->get(row)) {
+                rows.push_back(row);
+            }
+        }
+        return take(rows);
+    }
+
+    Series DataFrame::eval(const std::string &expression) const {
+        internal::Expression compiled{expression};
+
+        std::vector<const internal::Array *> columns;
+        for (const auto &name: compiled.columns()) {
+            internal::Value column{name};
+            if (!hasColumn(column) && !name.empty() && std::all_of(name.begin(), name.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+                column = internal::Value{static_cast<np::int_>(std::stoll(name))};
+            }
+            if (!hasColumn(column)) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Column not found: " + name);
+            }
+            const auto &values = operator[](column).values();
+            if (!internal::isNumeric(values)) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Column is not numeric: " + name);
+            }
+            columns.push_back(&values);
+        }
+
+        np::Size rows = empty() ? 0 : m_shape[0];
+        np::Array<np::float_> result{np::Shape{rows}};
+
+        // One scratch block per stack slot of the postfix program
+        std::vector<np::float_> scratch(compiled.stackDepth() * internal::kBlockSize);
+        for (np::Size begin = 0; begin < rows; begin += internal::kBlockSize) {
+            np::Size count = std::min(internal::kBlockSize, rows - begin);
+            np::Size depth = 0;
+            for (const auto &instruction: compiled.program()) {
+                np::float_ *top = scratch.data() + depth * internal::kBlockSize;
+                np::float_ *left = top - 2 * internal::kBlockSize;
+                np::float_ *right = top - internal::kBlockSize;
+                switch (instruction.opCode) {
+                    case internal::Expression::OpCode::kColumn:
+                        internal::loadBlock(*columns[instruction.column], begin, count, top);
+                        ++depth;
+                        break;
+                    case internal::Expression::OpCode::kConstant:
+                        std::fill(top, top + count, instruction.constant);
+                        ++depth;
+                        break;
+                    case internal::Expression::OpCode::kAdd:
+                        for (np::Size i = 0; i < count; ++i) {
+                            left[i] += right[i];
+                        }
+                        --depth;
+                        break;
+                    case internal::Expression::OpCode::kSubtract:
+                        for (np::Size i = 0; i < count; ++i) {
+                            left[i] -= right[i];
+                        }
+                        --depth;
+                        break;
+                    case internal::Expression::OpCode::kMultiply:
+                        for (np::Size i = 0; i < count; ++i) {
+                            left[i] *= right[i];
+                        }
+                        --depth;
+                        break;
+                    case internal::Expression::OpCode::kDivide:
+                        for (np::Size i = 0; i < count; ++i) {
+                            left[i] /= right[i];
+                        }
+                        --depth;
+                        break;
+                    case internal::Expression::OpCode::kNegate:
+                        for (np::Size i = 0; i < count; ++i) {
+                            right[i] = -right[i];
+                        }
+                        break;
+                }
+            }
+            for (np::Size i = 0; i < count; ++i) {
+                result.set(begin + i, scratch[i]);
+            }
+        }
+        return Series{std::move(result), m_index.labels(), internal::Value{}};
+    }
+
     DataFrame DataFrame::add(const DataFrame &dataFrame) const {
         if (dataFrame.ndim() != 1) {
             PD_THROW_WITH_STACKTRACE(std::runtime_error, "DataFrame must be 1D");
@@ -758,7 +1054,7 @@ namespace pd {
         DataFrame result;
         np::Size row = 0;
         for (const auto &columnName: m_columns.getIndex()) {
-            auto series = operator[](columnName);
+            const auto &series = operator[](columnName);
             if (series.dtype() == "int32") {
                 np::Array<np::int_> columnArray{np::Shape{shape()[0]}};
                 for (np::Size i = 0; i < shape()[0]; ++i) {
@@ -766,7 +1062,7 @@ namespace pd {
                     auto value2 = static_cast<np::int_>(dataFrame.at(row, internal::Value{0}));
                     columnArray.set(i, value1 + value2);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             } else if (series.dtype() == "float64") {
                 np::Array<np::float_> columnArray{np::Shape{shape()[0]}};
                 for (np::Size i = 0; i < shape()[0]; ++i) {
@@ -774,7 +1070,7 @@ namespace pd {
                     auto value2 = static_cast<np::float_>(dataFrame.at(row, internal::Value{0}));
                     columnArray.set(i, value1 + value2);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             } else {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown series type");
             }
@@ -791,7 +1087,7 @@ namespace pd {
         DataFrame result;
         np::Size row = 0;
         for (const auto &columnName: m_columns.getIndex()) {
-            auto series = operator[](columnName);
+            const auto &series = operator[](columnName);
             if (series.dtype() == "int32") {
                 np::Array<np::int_> columnArray{np::Shape{shape()[0]}};
                 for (np::Size i = 0; i < shape()[0]; ++i) {
@@ -799,7 +1095,7 @@ namespace pd {
                     auto value2 = static_cast<np::int_>(dataFrame.at(row, internal::Value{0}));
                     columnArray.set(i, value1 - value2);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             } else if (series.dtype() == "float64") {
                 np::Array<np::float_> columnArray{np::Shape{shape()[0]}};
                 for (np::Size i = 0; i < shape()[0]; ++i) {
@@ -807,7 +1103,7 @@ namespace pd {
                     auto value2 = static_cast<np::float_>(dataFrame.at(row, internal::Value{0}));
                     columnArray.set(i, value1 - value2);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             } else {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown series type");
             }
@@ -824,7 +1120,7 @@ namespace pd {
         DataFrame result;
         np::Size row = 0;
         for (const auto &columnName: m_columns.getIndex()) {
-            auto series = operator[](columnName);
+            const auto &series = operator[](columnName);
             if (series.dtype() == "int32") {
                 np::Array<np::int_> columnArray{np::Shape{shape()[0]}};
                 for (np::Size i = 0; i < shape()[0]; ++i) {
@@ -832,7 +1128,7 @@ namespace pd {
                     auto value2 = static_cast<np::int_>(dataFrame.at(row, internal::Value{0}));
                     columnArray.set(i, value1 * value2);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             } else if (series.dtype() == "float64") {
                 np::Array<np::float_> columnArray{np::Shape{shape()[0]}};
                 for (np::Size i = 0; i < shape()[0]; ++i) {
@@ -840,7 +1136,7 @@ namespace pd {
                     auto value2 = static_cast<np::float_>(dataFrame.at(row, internal::Value{0}));
                     columnArray.set(i, value1 * value2);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             } else {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown series type");
             }
@@ -857,7 +1153,7 @@ namespace pd {
         DataFrame result;
         np::Size row = 0;
         for (const auto &columnName: m_columns.getIndex()) {
-            auto series = operator[](columnName);
+            const auto &series = operator[](columnName);
             if (series.dtype() == "int32") {
                 np::Array<np::int_> columnArray{np::Shape{shape()[0]}};
                 for (np::Size i = 0; i < shape()[0]; ++i) {
@@ -865,7 +1161,7 @@ namespace pd {
                     auto value2 = static_cast<np::int_>(dataFrame.at(row, internal::Value{0}));
                     columnArray.set(i, value1 / value2);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             } else if (series.dtype() == "float64") {
                 np::Array<np::float_> columnArray{np::Shape{shape()[0]}};
                 for (np::Size i = 0; i < shape()[0]; ++i) {
@@ -873,7 +1169,7 @@ namespace pd {
                     auto value2 = static_cast<np::float_>(dataFrame.at(row, internal::Value{0}));
                     columnArray.set(i, value1 / value2);
                 }
-                result.append(Series{columnArray, columnName});
+                result.append(Series{std::move(columnArray), columnName});
             } else {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown series type");
             }
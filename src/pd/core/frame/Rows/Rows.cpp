@@ -0,0 +1,101 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+
+#include <pd/core/frame/DataFrame/DataFrame.hpp>
+#include <pd/core/frame/Rows/Rows.hpp>
+#include <pd/core/internal/Reduction.hpp>
+
+namespace pd {
+    np::float_ Row::number(np::Size column) const {
+        np::float_ value;
+        internal::loadBlock((*m_columns)[column]->values(), m_position, 1, &value);
+        return value;
+    }
+
+    Rows::Rows(const DataFrame &df)
+        : m_names{df.columns().getIndex()}, m_size{df.empty() ? 0 : df.shape()[0]} {
+        m_columns.reserve(m_names.size());
+        for (const auto &name: m_names) {
+            m_columns.push_back(&df[name]);
+        }
+    }
+
+    static np::Size findColumn(const std::vector<internal::Value> &names, const internal::Value &name) {
+        auto it = std::find(names.begin(), names.end(), name);
+        if (it == names.end()) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown column");
+        }
+        return static_cast<np::Size>(it - names.begin());
+    }
+
+    np::Size Rows::column(const internal::Value &name) const {
+        return findColumn(m_names, name);
+    }
+
+    RowBatches::RowBatches(const DataFrame &df, np::Size batchSize)
+        : m_size{df.empty() ? 0 : df.shape()[0]}, m_batchSize{std::max<np::Size>(batchSize, 1)} {
+        for (const auto &name: df.columns().getIndex()) {
+            const auto &values = df[name].values();
+            if (internal::isNumeric(values)) {
+                m_names.push_back(name);
+                m_arrays.push_back(&values);
+            }
+        }
+        if (m_size > 0) {
+            m_next = std::async(std::launch::async, &RowBatches::load, this, np::Size{0}, std::vector<np::float_>{});
+        }
+    }
+
+    bool RowBatches::next() {
+        if (!m_next.valid()) {
+            m_current = Batch{m_size, 0, std::move(m_current.values)};
+            return false;
+        }
+        auto buffer = std::move(m_current.values);
+        m_current = m_next.get();
+        auto nextBegin = m_current.begin + m_current.rows;
+        if (nextBegin < m_size) {
+            m_next = std::async(std::launch::async, &RowBatches::load, this, nextBegin, std::move(buffer));
+        }
+        return true;
+    }
+
+    np::Size RowBatches::column(const internal::Value &name) const {
+        return findColumn(m_names, name);
+    }
+
+    RowBatches::Batch RowBatches::load(np::Size begin, std::vector<np::float_> buffer) const {
+        Batch batch{begin, std::min(m_batchSize, m_size - begin), std::move(buffer)};
+        auto columnCount = columns();
+        batch.values.resize(batch.rows * columnCount);
+        std::vector<np::float_> column(batch.rows);
+        for (np::Size c = 0; c < columnCount; ++c) {
+            internal::loadBlock(*m_arrays[c], begin, batch.rows, column.data());
+            for (np::Size i = 0; i < batch.rows; ++i) {
+                batch.values[i * columnCount + c] = column[i];
+            }
+        }
+        return batch;
+    }
+}// namespace pd
@@ -0,0 +1,172 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/Expression.hpp>
+
+namespace pd {
+    namespace internal {
+        Expression::Expression(const std::string &expression)
+            : m_expression{expression} {
+            parseExpression();
+            skipSpaces();
+            if (!end()) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unexpected symbol '" + std::string{peek()} + "' in expression: " + m_expression);
+            }
+            if (m_program.empty()) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Empty expression");
+            }
+        }
+
+        void Expression::parseExpression() {
+            parseTerm();
+            while (true) {
+                skipSpaces();
+                if (end() || (peek() != '+' && peek() != '-')) {
+                    return;
+                }
+                char op = m_expression[m_position++];
+                parseTerm();
+                emit(Instruction{op == '+' ? OpCode::kAdd : OpCode::kSubtract});
+            }
+        }
+
+        void Expression::parseTerm() {
+            parseUnary();
+            while (true) {
+                skipSpaces();
+                if (end() || (peek() != '*' && peek() != '/')) {
+                    return;
+                }
+                char op = m_expression[m_position++];
+                parseUnary();
+                emit(Instruction{op == '*' ? OpCode::kMultiply : OpCode::kDivide});
+            }
+        }
+
+        void Expression::parseUnary() {
+            skipSpaces();
+            if (!end() && peek() == '-') {
+                ++m_position;
+                parseUnary();
+                emit(Instruction{OpCode::kNegate});
+                return;
+            }
+            if (!end() && peek() == '+') {
+                ++m_position;
+                parseUnary();
+                return;
+            }
+            parsePrimary();
+        }
+
+        void Expression::parsePrimary() {
+            skipSpaces();
+            if (end()) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unexpected end of expression: " + m_expression);
+            }
+            char c = peek();
+            if (c == '(') {
+                ++m_position;
+                parseExpression();
+                skipSpaces();
+                if (end() || peek() != ')') {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Missing ')' in expression: " + m_expression);
+                }
+                ++m_position;
+                return;
+            }
+            if (c == '`') {
+                auto close = m_expression.find('`', m_position + 1);
+                if (close == std::string::npos) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Missing closing '`' in expression: " + m_expression);
+                }
+                auto column = m_expression.substr(m_position + 1, close - m_position - 1);
+                m_position = close + 1;
+                emit(Instruction{OpCode::kColumn, addColumn(column)});
+                return;
+            }
+            if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+                const char *begin = m_expression.c_str() + m_position;
+                char *last{nullptr};
+                auto constant = std::strtod(begin, &last);
+                if (last == begin) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid number in expression: " + m_expression);
+                }
+                m_position += static_cast<std::size_t>(last - begin);
+                emit(Instruction{OpCode::kConstant, 0, constant});
+                return;
+            }
+            if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                auto begin = m_position;
+                while (!end() && (std::isalnum(static_cast<unsigned char>(peek())) || peek() == '_')) {
+                    ++m_position;
+                }
+                emit(Instruction{OpCode::kColumn, addColumn(m_expression.substr(begin, m_position - begin))});
+                return;
+            }
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unexpected symbol '" + std::string{c} + "' in expression: " + m_expression);
+        }
+
+        void Expression::skipSpaces() {
+            while (!end() && std::isspace(static_cast<unsigned char>(peek()))) {
+                ++m_position;
+            }
+        }
+
+        bool Expression::end() {
+            return m_position >= m_expression.size();
+        }
+
+        char Expression::peek() {
+            return m_expression[m_position];
+        }
+
+        void Expression::emit(const Instruction &instruction) {
+            switch (instruction.opCode) {
+                case OpCode::kColumn:
+                case OpCode::kConstant:
+                    m_stackDepth = std::max(m_stackDepth, ++m_depth);
+                    break;
+                case OpCode::kNegate:
+                    break;
+                default:
+                    --m_depth;
+                    break;
+            }
+            m_program.push_back(instruction);
+        }
+
+        np::Size Expression::addColumn(const std::string &column) {
+            auto it = std::find(m_columns.begin(), m_columns.end(), column);
+            if (it != m_columns.end()) {
+                return static_cast<np::Size>(it - m_columns.begin());
+            }
+            m_columns.push_back(column);
+            return static_cast<np::Size>(m_columns.size() - 1);
+        }
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,88 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/Factorize.hpp>
+
+namespace pd {
+    namespace internal {
+        static const constexpr np::Size kNotFound = HashTable<np::int_>::kNotFound;
+
+        template<typename DType>
+        static bool isNaNKey(const DType &key) {
+            if constexpr (std::is_floating_point_v<DType>) {
+                return std::isnan(key);
+            } else if constexpr (std::is_same_v<DType, Value>) {
+                return key.isFloat() && std::isnan(static_cast<np::float_>(key));
+            } else {
+                return false;
+            }
+        }
+
+        template<typename DType>
+        static Factorization factorize(const np::Array<DType> &data) {
+            auto size = data.size();
+            HashTable<DType> table;
+            Factorization result{std::vector<np::Size>(size), Array{}, std::vector<np::Size>{}, kNotFound};
+            for (np::Size i = 0; i < size; ++i) {
+                auto [id, inserted] = table.insert(data.get(i));
+                if (inserted) {
+                    result.counts.push_back(0);
+                }
+                ++result.counts[id];
+                result.codes[i] = id;
+            }
+
+            np::Array<DType> uniques{np::Shape{table.size()}};
+            for (np::Size id = 0; id < table.size(); ++id) {
+                const DType &key = table.keys()[id];
+                uniques.set(id, key);
+                if (isNaNKey(key)) {
+                    result.nanCode = id;
+                }
+            }
+            result.uniques = Array{std::move(uniques)};
+            return result;
+        }
+
+        Factorization factorize(const Array &data) {
+            if (data.isBoolArray()) {
+                return factorize(*static_cast<const np::Array<np::bool_> *>(data));
+            } else if (data.isIntCArray()) {
+                return factorize(*static_cast<const np::Array<np::intc> *>(data));
+            } else if (data.isIntArray()) {
+                return factorize(*static_cast<const np::Array<np::int_> *>(data));
+            } else if (data.isSizeArray()) {
+                return factorize(*static_cast<const np::Array<np::Size> *>(data));
+            } else if (data.isFloatArray()) {
+                return factorize(*static_cast<const np::Array<np::float_> *>(data));
+            } else if (data.isStringArray()) {
+                return factorize(*static_cast<const np::Array<np::string_> *>(data));
+            } else if (data.isUnicodeArray()) {
+                return factorize(*static_cast<const np::Array<np::unicode_> *>(data));
+            } else if (data.isValueArray()) {
+                return factorize(*static_cast<const np::Array<Value> *>(data));
+            }
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
+        }
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,108 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/HyperLogLog.hpp>
+
+namespace pd {
+    namespace internal {
+        HyperLogLog::HyperLogLog(np::Size precision)
+            : m_precision{precision} {
+            if (precision < 4 || precision > 18) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "HyperLogLog precision must be between 4 and 18");
+            }
+            m_registers.resize(static_cast<std::size_t>(1) << precision);
+        }
+
+        void HyperLogLog::add(std::uint64_t hash) {
+            auto index = static_cast<std::size_t>(hash >> (64 - m_precision));
+            auto rest = hash << m_precision;
+            auto maxRank = static_cast<int>(64 - m_precision);
+            auto rank = static_cast<std::uint8_t>(std::min(std::countl_zero(rest), maxRank) + 1);
+            m_registers[index] = std::max(m_registers[index], rank);
+        }
+
+        void HyperLogLog::merge(const HyperLogLog &other) {
+            if (other.m_precision != m_precision) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot merge HyperLogLog sketches of different precision");
+            }
+            // A byte-wise max loop, vectorized by the compiler
+            auto *registers = m_registers.data();
+            const auto *otherRegisters = other.m_registers.data();
+            for (std::size_t i = 0; i < m_registers.size(); ++i) {
+                registers[i] = std::max(registers[i], otherRegisters[i]);
+            }
+        }
+
+        static np::float_ sigma(np::float_ x) {
+            if (x == 1.0) {
+                return std::numeric_limits<np::float_>::infinity();
+            }
+            np::float_ y = 1.0;
+            np::float_ z = x;
+            np::float_ previous;
+            do {
+                x *= x;
+                previous = z;
+                z += x * y;
+                y += y;
+            } while (z != previous);
+            return z;
+        }
+
+        static np::float_ tau(np::float_ x) {
+            if (x == 0.0 || x == 1.0) {
+                return 0.0;
+            }
+            np::float_ y = 1.0;
+            np::float_ z = 1.0 - x;
+            np::float_ previous;
+            do {
+                x = std::sqrt(x);
+                previous = z;
+                y *= 0.5;
+                z -= (1.0 - x) * (1.0 - x) * y;
+            } while (z != previous);
+            return z / 3.0;
+        }
+
+        np::float_ HyperLogLog::estimate() const {
+            auto maxRank = 64 - m_precision;
+            std::vector<np::float_> histogram(maxRank + 2);
+            for (auto value: m_registers) {
+                ++histogram[value];
+            }
+            auto m = static_cast<np::float_>(m_registers.size());
+            auto z = m * tau(1.0 - histogram[maxRank + 1] / m);
+            for (auto k = maxRank; k >= 1; --k) {
+                z = 0.5 * (z + histogram[k]);
+            }
+            z += m * sigma(histogram[0] / m);
+            return m * m / (2.0 * std::log(2.0) * z);
+        }
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,398 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/LinearAlgebra.hpp>
+#include <pd/core/internal/Parallel.hpp>
+#include <pd/core/internal/Reduction.hpp>
+
+namespace pd {
+    namespace internal {
+        // Rows of every column kept in L1 while a tile of column pairs is accumulated
+        static const constexpr np::Size kGramRowBlock = 256;
+        // Columns of a register tile: kTile x kTile sums per pass over the rows
+        static const constexpr np::Size kTile = 4;
+        // Smallest number of rows worth a separate thread
+        static const constexpr np::Size kMinRowsPerThread = 1 << 14;
+
+        // Products summed directly at the leaves of the pairwise recursion
+        static const constexpr np::Size kPairwiseLeaf = 32;
+        // Rows of the result computed together by the matrix product: their accumulators stay in L1
+        static const constexpr np::Size kProductRowBlock = 256;
+        // Smallest number of multiply-adds of a matrix product worth a separate thread
+        static const constexpr np::Size kMinProductsPerThread = 1 << 20;
+
+        np::float_ dotBlock(const np::float_ *x, const np::float_ *y, np::Size size) {
+            np::float_ sums[4]{};
+            np::Size i = 0;
+            for (; i + 4 <= size; i += 4) {
+                sums[0] += x[i] * y[i];
+                sums[1] += x[i + 1] * y[i + 1];
+                sums[2] += x[i + 2] * y[i + 2];
+                sums[3] += x[i + 3] * y[i + 3];
+            }
+            for (; i < size; ++i) {
+                sums[0] += x[i] * y[i];
+            }
+            return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        }
+
+        np::float_ pairwiseDot(const np::float_ *x, const np::float_ *y, np::Size size) {
+            if (size <= kPairwiseLeaf) {
+                return dotBlock(x, y, size);
+            }
+            auto half = size / 2;
+            return pairwiseDot(x, y, half) + pairwiseDot(x + half, y + half, size - half);
+        }
+
+        void CompensatedSum::add(np::float_ value) {
+            auto total = sum + value;
+            if (std::abs(sum) >= std::abs(value)) {
+                compensation += (sum - total) + value;
+            } else {
+                compensation += (value - total) + sum;
+            }
+            sum = total;
+        }
+
+        void CompensatedSum::merge(const CompensatedSum &other) {
+            add(other.sum);
+            compensation += other.compensation;
+        }
+
+        void PairwiseSum::add(np::float_ value) {
+            np::Size level = 0;
+            for (auto count = m_count; (count & 1) != 0; count >>= 1, ++level) {
+                value += m_levels[level];
+            }
+            if (level == m_levels.size()) {
+                m_levels.push_back(value);
+            } else {
+                m_levels[level] = value;
+            }
+            ++m_count;
+        }
+
+        np::float_ PairwiseSum::result() const {
+            np::float_ result = 0.0;
+            for (np::Size level = 0; level < m_levels.size(); ++level) {
+                if ((m_count >> level & 1) != 0) {
+                    result += m_levels[level];
+                }
+            }
+            return result;
+        }
+
+        Matrix packColumns(const std::vector<const Array *> &arrays) {
+            Matrix matrix;
+            matrix.columns = static_cast<np::Size>(arrays.size());
+            matrix.rows = arrays.empty() ? 0 : arrays.front()->size();
+            for (const auto *array: arrays) {
+                if (array->size() != matrix.rows) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Columns have different sizes");
+                }
+            }
+            matrix.data.resize(matrix.rows * matrix.columns);
+            parallelFor(matrix.columns, 1, [&](np::Size, np::Size begin, np::Size end) {
+                for (np::Size i = begin; i < end; ++i) {
+                    loadBlock(*arrays[i], 0, matrix.rows, matrix.column(i));
+                }
+            });
+            return matrix;
+        }
+
+        // Replaces values[rows] by their 1-based ranks, tied values get the average of their ranks
+        static void rank(np::float_ *values, std::vector<np::Size> &rows) {
+            std::sort(rows.begin(), rows.end(), [values](np::Size row1, np::Size row2) {
+                return values[row1] < values[row2];
+            });
+            for (np::Size first = 0; first < rows.size();) {
+                auto last = first + 1;
+                while (last < rows.size() && values[rows[last]] == values[rows[first]]) {
+                    ++last;
+                }
+                auto average = static_cast<np::float_>(first + last + 1) / 2;
+                for (auto j = first; j < last; ++j) {
+                    values[rows[j]] = average;
+                }
+                first = last;
+            }
+        }
+
+        // Adds the products of rows [begin, end) of columns [i0, i0 + kTile) and [j0, j0 + kTile) to gram.
+        // Full tiles keep all sums in registers, so every loaded value takes part in kTile products.
+        static void gramTile(const Matrix &matrix, np::Size i0, np::Size j0, np::Size begin, np::Size end, np::float_ *gram) {
+            auto n = matrix.columns;
+            if (i0 + kTile <= n && j0 + kTile <= n) {
+                const np::float_ *x[kTile];
+                const np::float_ *y[kTile];
+                for (np::Size k = 0; k < kTile; ++k) {
+                    x[k] = matrix.column(i0 + k);
+                    y[k] = matrix.column(j0 + k);
+                }
+                np::float_ sums[kTile][kTile]{};
+                for (np::Size row = begin; row < end; ++row) {
+                    for (np::Size a = 0; a < kTile; ++a) {
+                        for (np::Size b = 0; b < kTile; ++b) {
+                            sums[a][b] += x[a][row] * y[b][row];
+                        }
+                    }
+                }
+                for (np::Size a = 0; a < kTile; ++a) {
+                    for (np::Size b = 0; b < kTile; ++b) {
+                        gram[(i0 + a) * n + j0 + b] += sums[a][b];
+                    }
+                }
+                return;
+            }
+            for (auto i = i0; i < std::min(i0 + kTile, n); ++i) {
+                for (auto j = j0; j < std::min(j0 + kTile, n); ++j) {
+                    const auto *x = matrix.column(i);
+                    const auto *y = matrix.column(j);
+                    np::float_ sum = 0;
+                    for (np::Size row = begin; row < end; ++row) {
+                        sum += x[row] * y[row];
+                    }
+                    gram[i * n + j] += sum;
+                }
+            }
+        }
+
+        // X^T X of a matrix without NaN. Threads reduce disjoint row ranges into private matrices
+        // that are summed at the end; within a range rows are taken in cache-sized blocks.
+        static std::vector<np::float_> gram(const Matrix &matrix) {
+            auto n = matrix.columns;
+            std::vector<std::vector<np::float_>> partial(chunkCount(matrix.rows, kMinRowsPerThread), std::vector<np::float_>(n * n, 0.0));
+            parallelFor(matrix.rows, kMinRowsPerThread, [&](np::Size chunk, np::Size begin, np::Size end) {
+                auto *result = partial[chunk].data();
+                for (auto blockBegin = begin; blockBegin < end; blockBegin += kGramRowBlock) {
+                    auto blockEnd = std::min(blockBegin + kGramRowBlock, end);
+                    for (np::Size i0 = 0; i0 < n; i0 += kTile) {
+                        for (auto j0 = i0; j0 < n; j0 += kTile) {
+                            gramTile(matrix, i0, j0, blockBegin, blockEnd, result);
+                        }
+                    }
+                }
+            });
+            std::vector<np::float_> result(n * n, 0.0);
+            for (const auto &sums: partial) {
+                for (np::Size i = 0; i < n * n; ++i) {
+                    result[i] += sums[i];
+                }
+            }
+            // Only the upper tiles were computed
+            for (np::Size i = 0; i < n; ++i) {
+                for (np::Size j = 0; j < i; ++j) {
+                    result[i * n + j] = result[j * n + i];
+                }
+            }
+            return result;
+        }
+
+        // Threads own disjoint row ranges of the result. For a block of rows and kTile result columns the
+        // accumulators stay in L1 while every column of the left matrix is streamed through them once.
+        Matrix multiply(const Matrix &matrix, const Matrix &other) {
+            if (matrix.columns != other.rows) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Shapes are not aligned");
+            }
+            Matrix result;
+            result.rows = matrix.rows;
+            result.columns = other.columns;
+            result.data.resize(result.rows * result.columns, 0.0);
+            auto inner = matrix.columns;
+            auto minRows = std::max<np::Size>(kProductRowBlock, kMinProductsPerThread / std::max<np::Size>(1, inner * other.columns));
+            parallelFor(matrix.rows, minRows, [&](np::Size, np::Size begin, np::Size end) {
+                for (auto blockBegin = begin; blockBegin < end; blockBegin += kProductRowBlock) {
+                    auto rows = std::min(kProductRowBlock, end - blockBegin);
+                    for (np::Size j0 = 0; j0 < other.columns; j0 += kTile) {
+                        auto tile = std::min(kTile, other.columns - j0);
+                        np::float_ *c[kTile];
+                        for (np::Size b = 0; b < tile; ++b) {
+                            c[b] = result.column(j0 + b) + blockBegin;
+                        }
+                        for (np::Size p = 0; p < inner; ++p) {
+                            const auto *a = matrix.column(p) + blockBegin;
+                            for (np::Size b = 0; b < tile; ++b) {
+                                auto weight = other.column(j0 + b)[p];
+                                auto *column = c[b];
+                                for (np::Size row = 0; row < rows; ++row) {
+                                    column[row] += a[row] * weight;
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+            return result;
+        }
+
+        // Co-moments of every pair of columns over the rows where both are not NaN
+        struct PairMoments {
+            np::Size count{0};
+            np::float_ comoment{0.0};
+            np::float_ m2x{0.0};
+            np::float_ m2y{0.0};
+        };
+
+        static PairMoments pairMoments(const np::float_ *x, const np::float_ *y, np::Size rows) {
+            PairMoments moments;
+            np::float_ meanX = 0;
+            np::float_ meanY = 0;
+            for (np::Size row = 0; row < rows; ++row) {
+                if (std::isnan(x[row]) || std::isnan(y[row])) {
+                    continue;
+                }
+                ++moments.count;
+                auto dx = x[row] - meanX;
+                meanX += dx / static_cast<np::float_>(moments.count);
+                auto dy = y[row] - meanY;
+                meanY += dy / static_cast<np::float_>(moments.count);
+                moments.comoment += dx * (y[row] - meanY);
+                moments.m2x += dx * (x[row] - meanX);
+                moments.m2y += dy * (y[row] - meanY);
+            }
+            return moments;
+        }
+
+        [[nodiscard]] static bool hasNaN(const Matrix &matrix) {
+            return std::any_of(matrix.data.begin(), matrix.data.end(), [](np::float_ value) {
+                return std::isnan(value);
+            });
+        }
+
+        // Calls function(i, j, moments) for every pair j >= i
+        template<typename Function>
+        static void forEachPair(Matrix &matrix, Function &&function) {
+            auto n = matrix.columns;
+            if (!hasNaN(matrix)) {
+                // Centering first makes the Gram matrix the matrix of co-moments
+                parallelFor(n, 1, [&matrix](np::Size, np::Size begin, np::Size end) {
+                    for (auto i = begin; i < end; ++i) {
+                        auto *column = matrix.column(i);
+                        Moments moments;
+                        for (np::Size row = 0; row < matrix.rows; row += kBlockSize) {
+                            moments.add(column + row, std::min(kBlockSize, matrix.rows - row));
+                        }
+                        for (np::Size row = 0; row < matrix.rows; ++row) {
+                            column[row] -= moments.mean;
+                        }
+                    }
+                });
+                auto comoments = gram(matrix);
+                for (np::Size i = 0; i < n; ++i) {
+                    for (auto j = i; j < n; ++j) {
+                        function(i, j, PairMoments{matrix.rows, comoments[i * n + j], comoments[i * n + i], comoments[j * n + j]});
+                    }
+                }
+                return;
+            }
+            // Every pair has its own set of complete rows
+            parallelFor(n, 1, [&](np::Size, np::Size begin, np::Size end) {
+                for (auto i = begin; i < end; ++i) {
+                    for (auto j = i; j < n; ++j) {
+                        function(i, j, pairMoments(matrix.column(i), matrix.column(j), matrix.rows));
+                    }
+                }
+            });
+        }
+
+        std::vector<np::float_> covariance(Matrix matrix, np::Size ddof, np::Size minPeriods) {
+            auto n = matrix.columns;
+            std::vector<np::float_> result(n * n);
+            forEachPair(matrix, [&](np::Size i, np::Size j, const PairMoments &moments) {
+                auto value = std::numeric_limits<np::float_>::quiet_NaN();
+                if (moments.count >= std::max<np::Size>(minPeriods, 1) && moments.count > ddof) {
+                    value = moments.comoment / static_cast<np::float_>(moments.count - ddof);
+                }
+                result[i * n + j] = value;
+                result[j * n + i] = value;
+            });
+            return result;
+        }
+
+        static np::float_ correlation(const PairMoments &moments, np::Size minPeriods) {
+            auto denominator = std::sqrt(moments.m2x * moments.m2y);
+            if (moments.count >= std::max<np::Size>(minPeriods, 1) && denominator > 0) {
+                return std::clamp(moments.comoment / denominator, -1.0, 1.0);
+            }
+            return std::numeric_limits<np::float_>::quiet_NaN();
+        }
+
+        std::vector<np::float_> correlation(Matrix matrix, np::Size minPeriods) {
+            auto n = matrix.columns;
+            std::vector<np::float_> result(n * n);
+            forEachPair(matrix, [&](np::Size i, np::Size j, const PairMoments &moments) {
+                result[i * n + j] = correlation(moments, minPeriods);
+                result[j * n + i] = result[i * n + j];
+            });
+            return result;
+        }
+
+        std::vector<np::float_> rankCorrelation(Matrix matrix, np::Size minPeriods) {
+            if (!hasNaN(matrix)) {
+                parallelFor(matrix.columns, 1, [&matrix](np::Size, np::Size begin, np::Size end) {
+                    std::vector<np::Size> rows(matrix.rows);
+                    for (auto i = begin; i < end; ++i) {
+                        std::iota(rows.begin(), rows.end(), 0);
+                        rank(matrix.column(i), rows);
+                    }
+                });
+                return correlation(std::move(matrix), minPeriods);
+            }
+            // Ranks depend on the rows both columns have, so they are taken pair by pair
+            auto n = matrix.columns;
+            std::vector<np::float_> result(n * n);
+            parallelFor(n, 1, [&](np::Size, np::Size begin, np::Size end) {
+                std::vector<np::Size> rows;
+                std::vector<np::float_> x;
+                std::vector<np::float_> y;
+                for (auto i = begin; i < end; ++i) {
+                    for (auto j = i; j < n; ++j) {
+                        const auto *column1 = matrix.column(i);
+                        const auto *column2 = matrix.column(j);
+                        x.clear();
+                        y.clear();
+                        for (np::Size row = 0; row < matrix.rows; ++row) {
+                            if (!std::isnan(column1[row]) && !std::isnan(column2[row])) {
+                                x.push_back(column1[row]);
+                                y.push_back(column2[row]);
+                            }
+                        }
+                        rows.resize(x.size());
+                        std::iota(rows.begin(), rows.end(), 0);
+                        rank(x.data(), rows);
+                        std::iota(rows.begin(), rows.end(), 0);
+                        rank(y.data(), rows);
+                        result[i * n + j] = correlation(pairMoments(x.data(), y.data(), x.size()), minPeriods);
+                        result[j * n + i] = result[i * n + j];
+                    }
+                }
+            });
+            return result;
+        }
+    }// namespace internal
+}// namespace pd
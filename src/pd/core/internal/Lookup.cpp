@@ -0,0 +1,288 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/BloomFilter.hpp>
+#include <pd/core/internal/HashTable.hpp>
+#include <pd/core/internal/Lookup.hpp>
+
+namespace pd {
+    namespace internal {
+        // Up to this many keys every row is compared with all of them
+        static const constexpr std::size_t kMaxLinearKeys = 8;
+        // Largest key range of an integer column served by a direct-index table
+        static const constexpr std::uint64_t kMaxDirectRange = 1 << 16;
+        // Bits of a membership bitmap per key up to which an integer key range counts as dense
+        static const constexpr std::uint64_t kMaxBitmapBitsPerKey = 64;
+        // From this many keys the hash table outgrows the cache and a Bloom filter rejects most misses first
+        static const constexpr std::size_t kMinBloomKeys = 1 << 15;
+
+        template<typename DType>
+        static bool convertKey(const Value &key, DType &result) {
+            if constexpr (std::is_same_v<DType, Value>) {
+                result = key;
+                return true;
+            } else if constexpr (std::is_arithmetic_v<DType>) {
+                long double number;
+                if (key.isBool()) {
+                    number = static_cast<np::bool_>(key) ? 1.0L : 0.0L;
+                } else if (key.isInt()) {
+                    number = static_cast<long double>(static_cast<np::int_>(key));
+                } else if (key.isIntC()) {
+                    number = static_cast<long double>(static_cast<np::intc>(key));
+                } else if (key.isSize()) {
+                    number = static_cast<long double>(static_cast<np::Size>(key));
+                } else if (key.isFloat()) {
+                    number = static_cast<long double>(static_cast<np::float_>(key));
+                } else {
+                    return false;
+                }
+                if constexpr (std::is_floating_point_v<DType>) {
+                    result = static_cast<DType>(number);
+                    return true;
+                } else {
+                    if (std::isnan(number) || number != std::trunc(number) ||
+                        number < static_cast<long double>(std::numeric_limits<DType>::lowest()) ||
+                        number > static_cast<long double>(std::numeric_limits<DType>::max())) {
+                        return false;
+                    }
+                    result = static_cast<DType>(number);
+                    return true;
+                }
+            } else if constexpr (std::is_same_v<DType, np::string_>) {
+                if (key.isString()) {
+                    result = *static_cast<const np::string_ *>(key);
+                    return true;
+                } else if (key.isUnicode()) {
+                    const auto *unicode = static_cast<const np::unicode_ *>(key);
+                    result.resize(unicode->length());
+                    std::transform(unicode->begin(), unicode->end(), result.begin(), [](wchar_t c) {
+                        return static_cast<char>(c);
+                    });
+                    return true;
+                }
+                return false;
+            } else if constexpr (std::is_same_v<DType, np::unicode_>) {
+                if (key.isUnicode()) {
+                    result = *static_cast<const np::unicode_ *>(key);
+                    return true;
+                } else if (key.isString()) {
+                    const auto *string = static_cast<const np::string_ *>(key);
+                    result.resize(string->length());
+                    std::transform(string->begin(), string->end(), result.begin(), [](char c) {
+                        return static_cast<wchar_t>(c);
+                    });
+                    return true;
+                }
+                return false;
+            } else {
+                return false;
+            }
+        }
+
+        template<typename DType>
+        static std::vector<DType> convertKeys(const std::vector<Value> &keys, std::vector<np::Size> *positions = nullptr) {
+            std::vector<DType> typedKeys;
+            typedKeys.reserve(keys.size());
+            for (np::Size i = 0; i < keys.size(); ++i) {
+                DType key{};
+                if (convertKey(keys[i], key)) {
+                    typedKeys.push_back(key);
+                    if (positions != nullptr) {
+                        positions->push_back(i);
+                    }
+                }
+            }
+            return typedKeys;
+        }
+
+        template<typename DType>
+        static std::vector<np::Size> lookup(const np::Array<DType> &data, const std::vector<Value> &keys) {
+            auto size = data.size();
+            std::vector<np::Size> result(size, kNoMatch);
+
+            std::vector<np::Size> positions;
+            auto typedKeys = convertKeys<DType>(keys, &positions);
+            if (typedKeys.empty()) {
+                return result;
+            }
+
+            if (typedKeys.size() <= kMaxLinearKeys) {
+                for (np::Size row = 0; row < size; ++row) {
+                    const DType &value = data.get(row);
+                    for (std::size_t i = 0; i < typedKeys.size(); ++i) {
+                        if (equalKeys<DType>(value, typedKeys[i])) {
+                            result[row] = positions[i];
+                            break;
+                        }
+                    }
+                }
+                return result;
+            }
+
+            if constexpr (std::is_integral_v<DType>) {
+                auto [minimum, maximum] = std::minmax_element(typedKeys.begin(), typedKeys.end());
+                auto lowest = static_cast<std::uint64_t>(*minimum);
+                auto range = static_cast<std::uint64_t>(*maximum) - lowest;
+                if (range < kMaxDirectRange) {
+                    std::vector<np::Size> table(range + 1, kNoMatch);
+                    for (std::size_t i = typedKeys.size(); i-- > 0;) {
+                        table[static_cast<std::uint64_t>(typedKeys[i]) - lowest] = positions[i];
+                    }
+                    for (np::Size row = 0; row < size; ++row) {
+                        auto offset = static_cast<std::uint64_t>(data.get(row)) - lowest;
+                        if (offset <= range) {
+                            result[row] = table[offset];
+                        }
+                    }
+                    return result;
+                }
+            }
+
+            HashTable<DType> table{static_cast<np::Size>(typedKeys.size())};
+            std::vector<np::Size> tablePositions;
+            for (std::size_t i = 0; i < typedKeys.size(); ++i) {
+                if (table.insert(typedKeys[i]).second) {
+                    tablePositions.push_back(positions[i]);
+                }
+            }
+            for (np::Size row = 0; row < size; ++row) {
+                auto id = table.find(data.get(row));
+                if (id != HashTable<DType>::kNotFound) {
+                    result[row] = tablePositions[id];
+                }
+            }
+            return result;
+        }
+
+        template<typename DType>
+        static std::vector<bool> isin(const np::Array<DType> &data, const std::vector<Value> &values) {
+            auto size = data.size();
+            std::vector<bool> result(size, false);
+
+            auto typedKeys = convertKeys<DType>(values);
+            if (typedKeys.empty()) {
+                return result;
+            }
+
+            if (typedKeys.size() <= kMaxLinearKeys) {
+                for (np::Size row = 0; row < size; ++row) {
+                    const DType &value = data.get(row);
+                    bool found = false;
+                    for (const auto &key: typedKeys) {
+                        found |= equalKeys<DType>(value, key);
+                    }
+                    result[row] = found;
+                }
+                return result;
+            }
+
+            if constexpr (std::is_integral_v<DType>) {
+                auto [minimum, maximum] = std::minmax_element(typedKeys.begin(), typedKeys.end());
+                auto lowest = static_cast<std::uint64_t>(*minimum);
+                auto range = static_cast<std::uint64_t>(*maximum) - lowest;
+                if (range < std::max<std::uint64_t>(kMaxDirectRange, typedKeys.size() * kMaxBitmapBitsPerKey)) {
+                    std::vector<std::uint64_t> bitmap(range / 64 + 1, 0);
+                    for (const auto &key: typedKeys) {
+                        auto offset = static_cast<std::uint64_t>(key) - lowest;
+                        bitmap[offset / 64] |= std::uint64_t{1} << (offset % 64);
+                    }
+                    for (np::Size row = 0; row < size; ++row) {
+                        auto offset = static_cast<std::uint64_t>(data.get(row)) - lowest;
+                        result[row] = offset <= range && (bitmap[offset / 64] >> (offset % 64) & 1) != 0;
+                    }
+                    return result;
+                }
+            }
+
+            HashTable<DType> table{static_cast<np::Size>(typedKeys.size())};
+            for (const auto &key: typedKeys) {
+                table.insert(key);
+            }
+            if (typedKeys.size() < kMinBloomKeys) {
+                for (np::Size row = 0; row < size; ++row) {
+                    result[row] = table.find(data.get(row)) != HashTable<DType>::kNotFound;
+                }
+                return result;
+            }
+
+            BloomFilter filter{table.size()};
+            for (const auto &key: table.keys()) {
+                filter.add(hashKey(key));
+            }
+            for (np::Size row = 0; row < size; ++row) {
+                const DType &value = data.get(row);
+                auto hash = hashKey(value);
+                result[row] = filter.mayContain(hash) && table.find(value, hash) != HashTable<DType>::kNotFound;
+            }
+            return result;
+        }
+
+        std::vector<bool> isin(const Array &data, const std::vector<Value> &values) {
+            if (data.isBoolArray()) {
+                return isin(*static_cast<const np::Array<np::bool_> *>(data), values);
+            } else if (data.isIntCArray()) {
+                return isin(*static_cast<const np::Array<np::intc> *>(data), values);
+            } else if (data.isIntArray()) {
+                return isin(*static_cast<const np::Array<np::int_> *>(data), values);
+            } else if (data.isSizeArray()) {
+                return isin(*static_cast<const np::Array<np::Size> *>(data), values);
+            } else if (data.isFloatArray()) {
+                return isin(*static_cast<const np::Array<np::float_> *>(data), values);
+            } else if (data.isStringArray()) {
+                return isin(*static_cast<const np::Array<np::string_> *>(data), values);
+            } else if (data.isUnicodeArray()) {
+                return isin(*static_cast<const np::Array<np::unicode_> *>(data), values);
+            } else if (data.isValueArray()) {
+                return isin(*static_cast<const np::Array<Value> *>(data), values);
+            }
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
+        }
+
+        std::vector<np::Size> lookup(const Array &data, const std::vector<Value> &keys) {
+            if (data.isBoolArray()) {
+                return lookup(*static_cast<const np::Array<np::bool_> *>(data), keys);
+            } else if (data.isIntCArray()) {
+                return lookup(*static_cast<const np::Array<np::intc> *>(data), keys);
+            } else if (data.isIntArray()) {
+                return lookup(*static_cast<const np::Array<np::int_> *>(data), keys);
+            } else if (data.isSizeArray()) {
+                return lookup(*static_cast<const np::Array<np::Size> *>(data), keys);
+            } else if (data.isFloatArray()) {
+                return lookup(*static_cast<const np::Array<np::float_> *>(data), keys);
+            } else if (data.isStringArray()) {
+                return lookup(*static_cast<const np::Array<np::string_> *>(data), keys);
+            } else if (data.isUnicodeArray()) {
+                return lookup(*static_cast<const np::Array<np::unicode_> *>(data), keys);
+            } else if (data.isValueArray()) {
+                return lookup(*static_cast<const np::Array<Value> *>(data), keys);
+            }
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
+        }
+    }// namespace internal
+}// namespace pd
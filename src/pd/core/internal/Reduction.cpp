@@ -0,0 +1,169 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cmath>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/Parallel.hpp>
+#include <pd/core/internal/Reduction.hpp>
+
+namespace pd {
+    namespace internal {
+        // Smallest number of rows worth a separate thread
+        static const constexpr np::Size kMinRowsPerThread = 1 << 16;
+
+        bool isNumeric(const Array &array) {
+            return array.isBoolArray() || array.isIntCArray() || array.isIntArray() || array.isSizeArray() ||
+                   array.isFloatArray() || array.isValueArray();
+        }
+
+        template<typename DType>
+        static void loadBlock(const np::Array<DType> &array, np::Size begin, np::Size count, np::float_ *block) {
+            for (np::Size i = 0; i < count; ++i) {
+                block[i] = static_cast<np::float_>(array.get(begin + i));
+            }
+        }
+
+        static void loadBlock(const np::Array<Value> &array, np::Size begin, np::Size count, np::float_ *block) {
+            for (np::Size i = 0; i < count; ++i) {
+                const auto &value = array.get(begin + i);
+                if (value.isInt()) {
+                    block[i] = static_cast<np::float_>(static_cast<np::int_>(value));
+                } else if (value.isIntC()) {
+                    block[i] = static_cast<np::float_>(static_cast<np::intc>(value));
+                } else if (value.isSize()) {
+                    block[i] = static_cast<np::float_>(static_cast<np::Size>(value));
+                } else if (value.isFloat()) {
+                    block[i] = static_cast<np::float_>(value);
+                } else {
+                    block[i] = std::numeric_limits<np::float_>::quiet_NaN();
+                }
+            }
+        }
+
+        void loadBlock(const Array &array, np::Size begin, np::Size count, np::float_ *block) {
+            if (array.isBoolArray()) {
+                loadBlock(*static_cast<const np::Array<np::bool_> *>(array), begin, count, block);
+            } else if (array.isIntCArray()) {
+                loadBlock(*static_cast<const np::Array<np::intc> *>(array), begin, count, block);
+            } else if (array.isIntArray()) {
+                loadBlock(*static_cast<const np::Array<np::int_> *>(array), begin, count, block);
+            } else if (array.isSizeArray()) {
+                loadBlock(*static_cast<const np::Array<np::Size> *>(array), begin, count, block);
+            } else if (array.isFloatArray()) {
+                loadBlock(*static_cast<const np::Array<np::float_> *>(array), begin, count, block);
+            } else if (array.isValueArray()) {
+                loadBlock(*static_cast<const np::Array<Value> *>(array), begin, count, block);
+            } else {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Array is not numeric");
+            }
+        }
+
+        void Moments::add(const np::float_ *values, np::Size size) {
+            // Block statistics with independent accumulators, then one merge per block
+            np::float_ sum[4]{};
+            np::Size counts[4]{};
+            np::float_ minimum = std::numeric_limits<np::float_>::infinity();
+            np::float_ maximum = -std::numeric_limits<np::float_>::infinity();
+            for (np::Size i = 0; i < size; ++i) {
+                auto value = values[i];
+                if (std::isnan(value)) {
+                    hasNaN = true;
+                    continue;
+                }
+                sum[i % 4] += value;
+                ++counts[i % 4];
+                minimum = std::min(minimum, value);
+                maximum = std::max(maximum, value);
+            }
+            Moments block;
+            block.count = counts[0] + counts[1] + counts[2] + counts[3];
+            if (block.count == 0) {
+                return;
+            }
+            block.mean = (sum[0] + sum[1] + sum[2] + sum[3]) / static_cast<np::float_>(block.count);
+            np::float_ m2[4]{};
+            for (np::Size i = 0; i < size; ++i) {
+                auto value = values[i];
+                if (!std::isnan(value)) {
+                    auto delta = value - block.mean;
+                    m2[i % 4] += delta * delta;
+                }
+            }
+            block.m2 = m2[0] + m2[1] + m2[2] + m2[3];
+            block.min = minimum;
+            block.max = maximum;
+            merge(block);
+        }
+
+        void Moments::merge(const Moments &other) {
+            hasNaN = hasNaN || other.hasNaN;
+            if (other.count == 0) {
+                return;
+            }
+            if (count == 0) {
+                count = other.count;
+                mean = other.mean;
+                m2 = other.m2;
+                min = other.min;
+                max = other.max;
+                return;
+            }
+            auto total = count + other.count;
+            auto delta = other.mean - mean;
+            auto weight = static_cast<np::float_>(other.count) / static_cast<np::float_>(total);
+            mean += delta * weight;
+            m2 += other.m2 + delta * delta * static_cast<np::float_>(count) * weight;
+            count = total;
+            min = std::min(min, other.min);
+            max = std::max(max, other.max);
+        }
+
+        np::float_ Moments::variance(np::Size ddof) const {
+            if (count <= ddof) {
+                return std::numeric_limits<np::float_>::quiet_NaN();
+            }
+            return m2 / static_cast<np::float_>(count - ddof);
+        }
+
+        Moments moments(const Array &array) {
+            if (!isNumeric(array)) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Array is not numeric");
+            }
+            auto size = array.size();
+            std::vector<Moments> partial(chunkCount(size, kMinRowsPerThread));
+            parallelFor(size, kMinRowsPerThread, [&](np::Size chunk, np::Size begin, np::Size end) {
+                np::float_ block[kBlockSize];
+                for (np::Size row = begin; row < end; row += kBlockSize) {
+                    auto count = std::min(kBlockSize, end - row);
+                    loadBlock(array, row, count, block);
+                    partial[chunk].add(block, count);
+                }
+            });
+            Moments result;
+            for (const auto &moments: partial) {
+                result.merge(moments);
+            }
+            return result;
+        }
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,201 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/Parallel.hpp>
+#include <pd/core/internal/Reduction.hpp>
+#include <pd/core/internal/Scan.hpp>
+
+namespace pd {
+    namespace internal {
+        // Smallest number of elements worth a separate thread
+        static const constexpr np::Size kMinScanRowsPerThread = 1 << 16;
+
+        template<typename DType>
+        static bool isMissing(DType value) {
+            if constexpr (std::is_floating_point_v<DType>) {
+                return std::isnan(value);
+            } else {
+                return false;
+            }
+        }
+
+        template<typename DType>
+        static DType identity(ScanFunction function) {
+            switch (function) {
+                case ScanFunction::kSum:
+                    return static_cast<DType>(0);
+                case ScanFunction::kProduct:
+                    return static_cast<DType>(1);
+                case ScanFunction::kMin:
+                    return std::numeric_limits<DType>::has_infinity ? std::numeric_limits<DType>::infinity() : std::numeric_limits<DType>::max();
+                case ScanFunction::kMax:
+                    return std::numeric_limits<DType>::has_infinity ? -std::numeric_limits<DType>::infinity() : std::numeric_limits<DType>::lowest();
+            }
+            return DType{};
+        }
+
+        template<typename DType>
+        static DType combine(ScanFunction function, DType accumulator, DType value) {
+            switch (function) {
+                case ScanFunction::kSum:
+                    return static_cast<DType>(accumulator + value);
+                case ScanFunction::kProduct:
+                    return static_cast<DType>(accumulator * value);
+                case ScanFunction::kMin:
+                    return std::min(accumulator, value);
+                case ScanFunction::kMax:
+                    return std::max(accumulator, value);
+            }
+            return accumulator;
+        }
+
+        template<typename Result, typename DType>
+        static np::Array<Result> scan(const np::Array<DType> &data, ScanFunction function) {
+            auto size = data.size();
+            np::Array<Result> result{np::Shape{size}};
+
+            // Pass 1: total of every chunk but the last one
+            auto chunks = chunkCount(size, kMinScanRowsPerThread);
+            // Not a std::vector: bool results would get the packed specialization
+            std::unique_ptr<Result[]> offsets{new Result[std::max<np::Size>(chunks, 1)]};
+            std::fill(offsets.get(), offsets.get() + chunks, identity<Result>(function));
+            if (chunks > 1) {
+                parallelFor(size, kMinScanRowsPerThread, [&](np::Size chunk, np::Size begin, np::Size end) {
+                    if (chunk + 1 == chunks) {
+                        return;
+                    }
+                    auto accumulator = identity<Result>(function);
+                    for (np::Size i = begin; i < end; ++i) {
+                        auto value = static_cast<Result>(data.get(i));
+                        if (!isMissing(value)) {
+                            accumulator = combine(function, accumulator, value);
+                        }
+                    }
+                    offsets[chunk + 1] = accumulator;
+                });
+                for (np::Size chunk = 1; chunk < chunks; ++chunk) {
+                    offsets[chunk] = combine(function, offsets[chunk - 1], offsets[chunk]);
+                }
+            }
+
+            // Pass 2: every chunk is scanned from the total of the preceding chunks
+            parallelFor(size, kMinScanRowsPerThread, [&](np::Size chunk, np::Size begin, np::Size end) {
+                auto accumulator = offsets[chunk];
+                for (np::Size i = begin; i < end; ++i) {
+                    auto value = static_cast<Result>(data.get(i));
+                    if (isMissing(value)) {
+                        result.set(i, value);
+                        continue;
+                    }
+                    accumulator = combine(function, accumulator, value);
+                    result.set(i, accumulator);
+                }
+            });
+            return result;
+        }
+
+        template<typename DType>
+        static Array scanInteger(const np::Array<DType> &data, ScanFunction function) {
+            if (function == ScanFunction::kMin || function == ScanFunction::kMax) {
+                return Array{scan<DType>(data, function)};
+            }
+            if constexpr (std::is_unsigned_v<DType> && !std::is_same_v<DType, np::bool_>) {
+                return Array{scan<np::Size>(data, function)};
+            } else {
+                return Array{scan<np::int_>(data, function)};
+            }
+        }
+
+        static np::Array<np::float_> toFloat(const Array &data) {
+            auto size = data.size();
+            np::Array<np::float_> result{np::Shape{size}};
+            np::float_ block[kBlockSize];
+            for (np::Size row = 0; row < size; row += kBlockSize) {
+                auto count = std::min(kBlockSize, size - row);
+                loadBlock(data, row, count, block);
+                for (np::Size i = 0; i < count; ++i) {
+                    result.set(row + i, block[i]);
+                }
+            }
+            return result;
+        }
+
+        Array scan(const Array &data, ScanFunction function) {
+            if (data.isBoolArray()) {
+                return scanInteger(*static_cast<const np::Array<np::bool_> *>(data), function);
+            } else if (data.isIntCArray()) {
+                return scanInteger(*static_cast<const np::Array<np::intc> *>(data), function);
+            } else if (data.isIntArray()) {
+                return scanInteger(*static_cast<const np::Array<np::int_> *>(data), function);
+            } else if (data.isSizeArray()) {
+                return scanInteger(*static_cast<const np::Array<np::Size> *>(data), function);
+            } else if (data.isFloatArray()) {
+                return Array{scan<np::float_>(*static_cast<const np::Array<np::float_> *>(data), function)};
+            } else if (data.isValueArray()) {
+                return Array{scan<np::float_>(toFloat(data), function)};
+            }
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot scan a non-number array");
+        }
+
+        // Calls function(i, j) for every row i that has a source row j = i - periods, sets the other rows to NaN
+        template<typename Function>
+        static np::Array<np::float_> shifted(np::Size size, np::int_ periods, Function &&function) {
+            np::Array<np::float_> result{np::Shape{size}};
+            for (np::Size i = 0; i < size; ++i) {
+                auto source = static_cast<np::int_>(i) - periods;
+                if (source < 0 || source >= static_cast<np::int_>(size)) {
+                    result.set(i, std::numeric_limits<np::float_>::quiet_NaN());
+                } else {
+                    result.set(i, function(static_cast<np::Size>(source), i));
+                }
+            }
+            return result;
+        }
+
+        np::Array<np::float_> diff(const Array &data, np::int_ periods) {
+            if (!isNumeric(data)) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot calculate diff of a non-number array");
+            }
+            auto values = toFloat(data);
+            return shifted(values.size(), periods, [&values](np::Size source, np::Size i) {
+                return values.get(i) - values.get(source);
+            });
+        }
+
+        np::Array<np::float_> shift(const Array &data, np::int_ periods) {
+            if (!isNumeric(data)) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot shift a non-number array");
+            }
+            auto values = toFloat(data);
+            return shifted(values.size(), periods, [&values](np::Size source, np::Size) {
+                return values.get(source);
+            });
+        }
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,154 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/TDigest.hpp>
+
+namespace pd {
+    namespace internal {
+        TDigest::TDigest(np::float_ compression)
+            : m_compression{compression} {
+            if (compression < 10.0) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "t-digest compression must be at least 10");
+            }
+        }
+
+        void TDigest::add(np::float_ value, np::float_ weight) {
+            if (std::isnan(value) || weight <= 0.0) {
+                return;
+            }
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+            m_buffer.push_back(Centroid{value, weight});
+            if (static_cast<np::float_>(m_buffer.size()) > 8.0 * m_compression) {
+                compress();
+            }
+        }
+
+        void TDigest::add(const np::float_ *values, np::Size size) {
+            for (np::Size i = 0; i < size; ++i) {
+                add(values[i]);
+            }
+        }
+
+        void TDigest::merge(const TDigest &other) {
+            other.compress();
+            for (const auto &centroid: other.m_centroids) {
+                m_buffer.push_back(centroid);
+            }
+            m_min = std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+            compress();
+        }
+
+        np::float_ TDigest::count() const {
+            compress();
+            return m_weight;
+        }
+
+        void TDigest::compress() const {
+            if (m_buffer.empty()) {
+                return;
+            }
+            std::vector<Centroid> all;
+            all.reserve(m_centroids.size() + m_buffer.size());
+            all.insert(all.end(), m_centroids.begin(), m_centroids.end());
+            all.insert(all.end(), m_buffer.begin(), m_buffer.end());
+            m_buffer.clear();
+            std::sort(all.begin(), all.end(), [](const Centroid &c1, const Centroid &c2) { return c1.mean < c2.mean; });
+
+            np::float_ total = 0.0;
+            for (const auto &centroid: all) {
+                total += centroid.weight;
+            }
+
+            m_centroids.clear();
+            np::float_ weightSoFar = 0.0;
+            Centroid current = all.front();
+            for (std::size_t i = 1; i < all.size(); ++i) {
+                const auto &next = all[i];
+                auto proposed = current.weight + next.weight;
+                auto q0 = weightSoFar / total;
+                auto q2 = (weightSoFar + proposed) / total;
+                // Size bound of the k2 scale function: centroids shrink towards q = 0 and q = 1
+                auto limit = 4.0 * total * std::min(q0 * (1.0 - q0), q2 * (1.0 - q2)) / m_compression;
+                if (proposed <= std::max(limit, 1.0)) {
+                    current.mean += (next.mean - current.mean) * next.weight / proposed;
+                    current.weight = proposed;
+                } else {
+                    weightSoFar += current.weight;
+                    m_centroids.push_back(current);
+                    current = next;
+                }
+            }
+            m_centroids.push_back(current);
+            m_weight = total;
+        }
+
+        np::float_ TDigest::quantile(np::float_ q) const {
+            if (q < 0.0 || q > 1.0) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Quantile must be between 0 and 1");
+            }
+            compress();
+            if (m_centroids.empty()) {
+                return std::numeric_limits<np::float_>::quiet_NaN();
+            }
+            if (m_centroids.size() == 1) {
+                return m_centroids.front().mean;
+            }
+
+            auto index = q * m_weight;
+            // Between the minimum and the center of the first centroid
+            const auto &first = m_centroids.front();
+            if (index < first.weight / 2.0) {
+                return m_min + (first.mean - m_min) * index / (first.weight / 2.0);
+            }
+            np::float_ cumulative = first.weight / 2.0;
+            for (std::size_t i = 0; i + 1 < m_centroids.size(); ++i) {
+                const auto &left = m_centroids[i];
+                const auto &right = m_centroids[i + 1];
+                auto step = (left.weight + right.weight) / 2.0;
+                if (index < cumulative + step) {
+                    // Singleton centroids are exact values
+                    if (left.weight == 1.0 && index - cumulative < 0.5) {
+                        return left.mean;
+                    }
+                    if (right.weight == 1.0 && cumulative + step - index <= 0.5) {
+                        return right.mean;
+                    }
+                    return left.mean + (right.mean - left.mean) * (index - cumulative) / step;
+                }
+                cumulative += step;
+            }
+            // Between the center of the last centroid and the maximum
+            const auto &last = m_centroids.back();
+            auto rest = m_weight - cumulative;
+            if (rest <= 0.0) {
+                return m_max;
+            }
+            return last.mean + (m_max - last.mean) * std::min(1.0, (index - cumulative) / rest);
+        }
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,62 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/Take.hpp>
+
+namespace pd {
+    namespace internal {
+        template<typename DType>
+        static np::Array<DType> take(const np::Array<DType> &data, const std::vector<np::Size> &rows) {
+            np::Array<DType> result{np::Shape{static_cast<np::Size>(rows.size())}};
+            auto size = data.size();
+            for (np::Size i = 0; i < rows.size(); ++i) {
+                if (rows[i] >= size) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Row index out of bounds");
+                }
+                result.set(i, data.get(rows[i]));
+            }
+            return result;
+        }
+
+        Array take(const Array &data, const std::vector<np::Size> &rows) {
+            if (data.isBoolArray()) {
+                return Array{take(*static_cast<const np::Array<np::bool_> *>(data), rows)};
+            } else if (data.isIntCArray()) {
+                return Array{take(*static_cast<const np::Array<np::intc> *>(data), rows)};
+            } else if (data.isIntArray()) {
+                return Array{take(*static_cast<const np::Array<np::int_> *>(data), rows)};
+            } else if (data.isSizeArray()) {
+                return Array{take(*static_cast<const np::Array<np::Size> *>(data), rows)};
+            } else if (data.isFloatArray()) {
+                return Array{take(*static_cast<const np::Array<np::float_> *>(data), rows)};
+            } else if (data.isStringArray()) {
+                return Array{take(*static_cast<const np::Array<np::string_> *>(data), rows)};
+            } else if (data.isUnicodeArray()) {
+                return Array{take(*static_cast<const np::Array<np::unicode_> *>(data), rows)};
+            } else if (data.isValueArray()) {
+                return Array{take(*static_cast<const np::Array<Value> *>(data), rows)};
+            }
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
+        }
+    }// namespace internal
+}// namespace pd
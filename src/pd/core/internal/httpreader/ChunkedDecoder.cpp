@@ -0,0 +1,138 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/httpreader/ChunkedDecoder.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+            static int hexDigit(char c) {
+                if (c >= '0' && c <= '9') {
+                    return c - '0';
+                }
+                if (c >= 'a' && c <= 'f') {
+                    return c - 'a' + 10;
+                }
+                if (c >= 'A' && c <= 'F') {
+                    return c - 'A' + 10;
+                }
+                return -1;
+            }
+
+            void ChunkedDecoder::onSizeLine() {
+                if (m_sizeDigits == 0) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid chunk size");
+                }
+                m_sizeDigits = 0;
+                m_state = m_chunkSize == 0 ? State::kTrailer : State::kData;
+            }
+
+            std::size_t ChunkedDecoder::decode(const char *data, std::size_t size, const Callback &callback) {
+                std::size_t pos = 0;
+                while (pos < size && m_state != State::kComplete) {
+                    if (m_state == State::kData) {
+                        // The payload is passed on as a whole slice, the rest is parsed byte by byte
+                        std::size_t count = std::min(m_chunkSize, size - pos);
+                        callback(data + pos, count);
+                        pos += count;
+                        m_chunkSize -= count;
+                        if (m_chunkSize == 0) {
+                            m_state = State::kDataCarriageReturn;
+                        }
+                        continue;
+                    }
+                    char c = data[pos++];
+                    switch (m_state) {
+                        case State::kSize: {
+                            int digit = hexDigit(c);
+                            if (digit >= 0) {
+                                if (m_chunkSize > (std::numeric_limits<std::size_t>::max() >> 4)) {
+                                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Too big chunk");
+                                }
+                                m_chunkSize = (m_chunkSize << 4) | static_cast<std::size_t>(digit);
+                                ++m_sizeDigits;
+                            } else if (c == ';' || c == ' ' || c == '\t') {
+                                m_state = State::kExtension;
+                            } else if (c == '\r') {
+                                m_state = State::kSizeLineFeed;
+                            } else if (c == '\n') {
+                                onSizeLine();
+                            } else {
+                                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid chunk size");
+                            }
+                            break;
+                        }
+                        case State::kExtension:
+                            // Chunk extensions are ignored
+                            if (c == '\r') {
+                                m_state = State::kSizeLineFeed;
+                            } else if (c == '\n') {
+                                onSizeLine();
+                            }
+                            break;
+                        case State::kSizeLineFeed:
+                            if (c != '\n') {
+                                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid chunk size");
+                            }
+                            onSizeLine();
+                            break;
+                        case State::kDataCarriageReturn:
+                            if (c == '\r') {
+                                m_state = State::kDataLineFeed;
+                            } else if (c == '\n') {
+                                m_state = State::kSize;
+                            } else {
+                                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid chunk end");
+                            }
+                            break;
+                        case State::kDataLineFeed:
+                            if (c != '\n') {
+                                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid chunk end");
+                            }
+                            m_state = State::kSize;
+                            break;
+                        case State::kTrailer:
+                            // Trailer fields are skipped up to the empty line that ends the body
+                            if (c == '\n') {
+                                if (m_trailerLineLength == 0) {
+                                    m_state = State::kComplete;
+                                }
+                                m_trailerLineLength = 0;
+                            } else if (c != '\r') {
+                                ++m_trailerLineLength;
+                            }
+                            break;
+                        case State::kData:
+                        case State::kComplete:
+                            break;
+                    }
+                }
+                return pos;
+            }
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,93 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifdef _WIN32
+#include <Winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+#include <pd/core/internal/httpreader/ConnectionPool.hpp>
+
+#ifdef _WIN32
+static inline int poll(struct pollfd *pfd, int nfds, int timeout) { return WSAPoll(pfd, nfds, timeout); }
+#endif
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+            // An idle HTTP connection has nothing to read, so a readable one was closed by the server
+            // or is out of sync with it
+            static bool isAlive(const Stream &stream) {
+                if (!stream.isOpened()) {
+                    return false;
+                }
+                pollfd fd{};
+                fd.fd = stream.getSocket().socket();
+                fd.events = POLLIN;
+                return ::poll(&fd, 1, 0) == 0;
+            }
+
+            ConnectionPool &ConnectionPool::instance() {
+                static ConnectionPool pool;
+                return pool;
+            }
+
+            ConnectionPool::Key ConnectionPool::makeKey(const Uri &uri) {
+                return Key{uri.m_scheme, uri.m_address.ipAddressOrName(), uri.m_address.port()};
+            }
+
+            StreamPtr ConnectionPool::acquire(const Uri &uri) {
+                std::lock_guard lock{m_mutex};
+                auto it = m_idle.find(makeKey(uri));
+                if (it == m_idle.end()) {
+                    return nullptr;
+                }
+                auto &connections = it->second;
+                auto now = std::chrono::steady_clock::now();
+                // The most recently used connection is the least likely to have timed out on the server
+                while (!connections.empty()) {
+                    auto connection = std::move(connections.back());
+                    connections.pop_back();
+                    if (now - connection.idleSince < kMaxIdleTime && isAlive(*connection.stream)) {
+                        return connection.stream;
+                    }
+                }
+                return nullptr;
+            }
+
+            void ConnectionPool::release(const Uri &uri, StreamPtr stream) {
+                std::lock_guard lock{m_mutex};
+                auto &connections = m_idle[makeKey(uri)];
+                if (connections.size() >= kMaxIdlePerHost) {
+                    connections.erase(connections.begin());
+                }
+                connections.push_back(Connection{std::move(stream), std::chrono::steady_clock::now()});
+            }
+
+            void ConnectionPool::clear() {
+                std::lock_guard lock{m_mutex};
+                m_idle.clear();
+            }
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
@@ -0,0 +1,151 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <system_error>
+
+#include <pd/core/internal/httpreader/HttpCache.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+
+            static constexpr const char *kBodyExtension = ".body";
+            static constexpr const char *kMetaExtension = ".meta";
+            static constexpr const char *kETagField = "ETag: ";
+            static constexpr const char *kLastModifiedField = "Last-Modified: ";
+
+            // FNV-1a: file names must not change between runs and platforms, unlike std::hash
+            static std::uint64_t hashUrl(const std::string &url) {
+                std::uint64_t hash = 14695981039346656037ULL;
+                for (unsigned char c: url) {
+                    hash ^= c;
+                    hash *= 1099511628211ULL;
+                }
+                return hash;
+            }
+
+            static std::filesystem::path withExtension(const std::filesystem::path &base, const std::string &extension) {
+                return std::filesystem::path{base.string() + extension};
+            }
+
+            HttpCache::HttpCache(std::filesystem::path directory)
+                : m_directory{std::move(directory)} {
+                std::filesystem::create_directories(m_directory);
+            }
+
+            std::filesystem::path HttpCache::base(const std::string &url) const {
+                std::ostringstream name;
+                name << std::hex << std::setw(16) << std::setfill('0') << hashUrl(url);
+                return m_directory / name.str();
+            }
+
+            std::optional<HttpCache::Entry> HttpCache::find(const std::string &url) const {
+                auto entryBase = base(url);
+                std::ifstream meta{withExtension(entryBase, kMetaExtension)};
+                std::string storedUrl;
+                if (!std::getline(meta, storedUrl) || storedUrl != url) {
+                    return std::nullopt;
+                }
+                Entry entry{withExtension(entryBase, kBodyExtension), {}};
+                std::string line;
+                while (std::getline(meta, line)) {
+                    if (line.rfind(kETagField, 0) == 0) {
+                        entry.validators.etag = line.substr(std::char_traits<char>::length(kETagField));
+                    } else if (line.rfind(kLastModifiedField, 0) == 0) {
+                        entry.validators.lastModified = line.substr(std::char_traits<char>::length(kLastModifiedField));
+                    }
+                }
+                std::error_code error;
+                if (entry.validators.empty() || !std::filesystem::is_regular_file(entry.body, error)) {
+                    return std::nullopt;
+                }
+                return entry;
+            }
+
+            HttpCache::Writer::Writer(const HttpCache &cache, const std::string &url)
+                : m_base{cache.base(url)}, m_url{url} {
+                // Several processes may download the same url into a shared directory
+                std::random_device random;
+                std::ostringstream suffix;
+                suffix << "." << std::hex << random() << random() << ".tmp";
+                m_temporary = withExtension(m_base, suffix.str());
+                m_stream.open(m_temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+            }
+
+            HttpCache::Writer::~Writer() {
+                if (!m_committed) {
+                    m_stream.close();
+                    std::error_code error;
+                    std::filesystem::remove(m_temporary, error);
+                }
+            }
+
+            void HttpCache::Writer::write(const char *data, std::size_t size) {
+                // A failure to store the body must not fail the download, so errors only spoil the entry
+                m_stream.write(data, static_cast<std::streamsize>(size));
+            }
+
+            void HttpCache::Writer::commit(const CacheValidators &validators) {
+                m_stream.close();
+                if (!m_stream || validators.empty()) {
+                    return;
+                }
+
+                auto metaTemporary = withExtension(m_temporary, kMetaExtension);
+                {
+                    std::ofstream meta{metaTemporary, std::ios::out | std::ios::trunc};
+                    meta << m_url << "\n";
+                    if (!validators.etag.empty()) {
+                        meta << kETagField << validators.etag << "\n";
+                    }
+                    if (!validators.lastModified.empty()) {
+                        meta << kLastModifiedField << validators.lastModified << "\n";
+                    }
+                    if (!meta) {
+                        std::error_code error;
+                        std::filesystem::remove(metaTemporary, error);
+                        return;
+                    }
+                }
+
+                // The old metadata goes first: while it is missing the entry is a miss, not a mismatched body
+                std::error_code error;
+                auto meta = withExtension(m_base, kMetaExtension);
+                std::filesystem::remove(meta, error);
+                std::filesystem::rename(m_temporary, withExtension(m_base, kBodyExtension), error);
+                if (error) {
+                    std::filesystem::remove(metaTemporary, error);
+                    return;
+                }
+                m_committed = true;
+                std::filesystem::rename(metaTemporary, meta, error);
+                if (error) {
+                    std::filesystem::remove(metaTemporary, error);
+                }
+            }
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
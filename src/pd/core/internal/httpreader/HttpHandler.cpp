@@ -27,6 +27,7 @@ SOFTWARE.
 #endif
 
 #include <pd/Exception.hpp>
+#include <pd/core/internal/httpreader/ConnectionPool.hpp>
 #include <pd/core/internal/httpreader/Connector.hpp>
 #include <pd/core/internal/httpreader/HttpHandler.hpp>
 
@@ -34,22 +35,53 @@ namespace pd {
     namespace internal {
         namespace httpreader {
             HttpHandler::HttpHandler(const std::string &userAgent,
-                                     const Uri &uri, HttpReader::Callback callback, HttpReader::RedirectCallback redirectCallback) {
-                m_stream = std::make_shared<Stream>();
-                connect(m_stream, uri.m_address);
+                                     const Uri &uri, HttpReader::Callback callback, HttpReader::RedirectCallback redirectCallback,
+                                     HttpMessage::Method method, const std::optional<ByteRange> &range, const CacheValidators &validators)
+                : m_uri{uri}, m_method{method} {
+                m_stream = ConnectionPool::instance().acquire(uri);
+                m_reused = m_stream != nullptr;
+                if (!m_stream) {
+                    m_stream = std::make_shared<Stream>();
+                    connect(m_stream, uri.m_address);
+                }
 
-                m_reader = std::make_unique<HttpReader>(callback, redirectCallback);
+                m_reader = std::make_unique<HttpReader>(callback, redirectCallback, method);
                 m_writer = std::make_unique<HttpWriter>(userAgent, uri);
+                if (range) {
+                    m_writer->setRange(*range);
+                }
+                m_writer->setValidators(validators);
 
-                m_writer->request();
+                m_writer->request(method);
                 m_mode = Mode::kWrite;
             }
 
             void HttpHandler::handle(short revents) {
+                try {
+                    exchange(revents);
+                } catch (const std::exception &) {
+                    // The server may have closed an idle connection just as it was taken from the pool.
+                    // GET and HEAD are idempotent, so the request is sent once more over a new connection.
+                    bool idempotent = m_method == HttpMessage::Method::kGet || m_method == HttpMessage::Method::kHead;
+                    if (!m_reused || !idempotent || m_reader->hasReceived()) {
+                        throw;
+                    }
+                    m_reused = false;
+                    auto stream = std::make_shared<Stream>();
+                    connect(stream, m_uri.m_address);
+                    m_stream = stream;
+                    m_mode = Mode::kWrite;
+                }
+            }
+
+            void HttpHandler::exchange(short revents) {
                 if (revents & POLLIN) {
                     m_reader->read(m_stream);
                     if (m_reader->isReadComplete()) {
                         m_mode = Mode::kFinish;
+                        if (m_reader->isKeepAlive()) {
+                            ConnectionPool::instance().release(m_uri, m_stream);
+                        }
                     }
                 }
                 if (revents & POLLOUT) {
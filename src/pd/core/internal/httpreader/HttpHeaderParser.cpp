@@ -0,0 +1,79 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstring>
+#include <stdexcept>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/httpreader/HttpHeaderParser.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+
+            std::size_t HttpHeaderParser::parse(const char *data, std::size_t size) {
+                std::size_t consumed = 0;
+                while (!m_complete && consumed < size) {
+                    const char *begin = data + consumed;
+                    std::size_t left = size - consumed;
+                    auto end = static_cast<const char *>(std::memchr(begin, '\n', left));
+                    if (end == nullptr) {
+                        if (m_headerSize + left > kMaxHttpHeaderSize) {
+                            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Too big header");
+                        }
+                        m_partialLine.append(begin, left);
+                        m_headerSize += left;
+                        consumed = size;
+                        break;
+                    }
+
+                    std::size_t length = static_cast<std::size_t>(end - begin) + 1;
+                    m_headerSize += length;
+                    if (m_headerSize > kMaxHttpHeaderSize) {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Too big header");
+                    }
+                    consumed += length;
+
+                    if (m_partialLine.empty()) {
+                        onLine(std::string_view{begin, length - 1});
+                    } else {
+                        m_partialLine.append(begin, length - 1);
+                        onLine(m_partialLine);
+                        m_partialLine.clear();
+                    }
+                }
+                return consumed;
+            }
+
+            void HttpHeaderParser::onLine(std::string_view line) {
+                if (!line.empty() && line.back() == '\r') {
+                    line.remove_suffix(1);
+                }
+                if (line.empty()) {
+                    m_complete = true;
+                    return;
+                }
+                m_message.parseLine(line);
+            }
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
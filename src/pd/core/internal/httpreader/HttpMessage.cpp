@@ -21,6 +21,7 @@ SOFTWARE.
 */
 
 #include <cassert>
+#include <charconv>
 #include <cstring>
 #include <iomanip>
 #include <sstream>
@@ -28,7 +29,10 @@ SOFTWARE.
 #include <pd/Exception.hpp>
 #include <pd/core/internal/Utils.hpp>
 #include <pd/core/internal/base64/Base64.hpp>
+#include <pd/core/internal/httpreader/ChunkedDecoder.hpp>
+#include <pd/core/internal/httpreader/HttpHeaderParser.hpp>
 #include <pd/core/internal/httpreader/HttpMessage.hpp>
+#include <pd/core/internal/httpreader/Inflater.hpp>
 
 namespace pd {
     namespace internal {
@@ -37,7 +41,6 @@ namespace pd {
             static constexpr const char kCookieValueSeparator = '=';
             static constexpr const char kStringSeparator[] = "\r\n";
             static constexpr const char *kMethodTag[] = {"", "OPTIONS", "GET", "HEAD", "POST", "PUT", "DELETE", "TRACE", "CONNECT"};
-            static constexpr const std::size_t kSeparatorLen = sizeof(kStringSeparator) - 1;
             static constexpr const char *kUserAgentTag = "User-Agent";
             static constexpr const char *kHostTag = "Host";
             static constexpr const char *kContentLengthTag = "Content-Length";
@@ -45,33 +48,57 @@ namespace pd {
             static constexpr const char *kContentTypeStrs[] = {"", "application/octet-stream", "text/xml", "text/html", "text/plain"};
             static constexpr const char *kContentTransferEncodingTag = "Content-Transfer-Encoding";
             static constexpr const char *kContentTransferEncodingStrs[] = {"", "7bit", "quoted-printable", "base64", "8bit", "binary", "x-token"};
+            static constexpr const char *kTransferEncodingTag = "Transfer-Encoding";
+            static constexpr const char *kChunkedStr = "chunked";
+            static constexpr const char *kContentEncodingTag = "Content-Encoding";
+            static constexpr const char *kAcceptEncodingTag = "Accept-Encoding";
+            static constexpr const char *kAcceptedEncodings = "gzip, deflate";
+            static constexpr const char *kConnectionTag = "Connection";
+            static constexpr const char *kRangeTag = "Range";
+            static constexpr const char *kAcceptRangesTag = "Accept-Ranges";
+            static constexpr const char *kContentRangeTag = "Content-Range";
+            static constexpr const char *kIfRangeTag = "If-Range";
+            static constexpr const char *kBytesUnit = "bytes";
             static constexpr const char *kDateTag = "Date";
             static constexpr const char *kDateTimeFormat = "%b, %d %Y %H:%M:%S GMT";
             static constexpr const char *kCookieTag = "Cookie";
             static constexpr const char *kSetCookieTag = "Set-Cookie";
             static constexpr const char *kLocationTag = "Location";
+            static constexpr const char *kETagTag = "ETag";
+            static constexpr const char *kLastModifiedTag = "Last-Modified";
+            static constexpr const char *kIfNoneMatchTag = "If-None-Match";
+            static constexpr const char *kIfModifiedSinceTag = "If-Modified-Since";
 
             HttpMessage::HttpMessage(const std::string &message)
                 : HttpMessage{} {
-                std::size_t prevPos = 0;
-                std::size_t pos = message.find(kStringSeparator);
-                while (pos != std::string::npos) {
-                    std::string line = message.substr(prevPos, pos - prevPos);
-                    if (line.empty()) {
-                        break;// header ended
-                    }
-
-                    prevPos = pos + kSeparatorLen;
-                    parseLine(line);
-                    pos = message.find(kStringSeparator, prevPos);
-                }
+                HttpHeaderParser parser{*this};
+                parser.parse(message.data(), message.size());
 
-                if (pos != std::string::npos) {
-                    m_headerSize = pos + kSeparatorLen;
+                if (parser.isComplete()) {
+                    m_headerSize = parser.headerSize();
 
                     std::string encoded = message.substr(m_headerSize);
 
-                    m_wellFormed = encoded.length() == m_contentLength;
+                    if (m_chunked) {
+                        ChunkedDecoder decoder;
+                        std::string body;
+                        decoder.decode(encoded.data(), encoded.size(), [&body](const char *data, std::size_t size) {
+                            body.append(data, size);
+                        });
+                        m_wellFormed = decoder.isComplete();
+                        encoded.swap(body);
+                    } else {
+                        m_wellFormed = encoded.length() == m_contentLength;
+                    }
+                    if (m_wellFormed && m_contentEncoding != ContentEncoding::kIdentity) {
+                        Inflater inflater{m_contentEncoding};
+                        std::string body;
+                        inflater.inflate(encoded.data(), encoded.size(), [&body](const char *data, std::size_t size) {
+                            body.append(data, size);
+                        });
+                        m_wellFormed = inflater.isComplete();
+                        encoded.swap(body);
+                    }
 
                     if (m_wellFormed && !encoded.empty()) {
                         decodeData(encoded);
@@ -91,13 +118,26 @@ namespace pd {
                 return stream.str();
             }
 
-            void HttpMessage::parseLine(std::string &line) {
-                static const char *kFieldSeparator = ":";
+            // Splits off the next token delimited by spaces or tabs
+            static std::string_view nextToken(std::string_view &line) {
                 static const char *kStatusSeparator = " \t";
+                auto begin = line.find_first_not_of(kStatusSeparator);
+                if (begin == std::string_view::npos) {
+                    line = {};
+                    return {};
+                }
+                auto end = line.find_first_of(kStatusSeparator, begin);
+                auto token = line.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+                line.remove_prefix(end == std::string_view::npos ? line.size() : end);
+                return token;
+            }
+
+            void HttpMessage::parseLine(std::string_view line) {
+                static const char kFieldSeparator = ':';
 
                 if (!m_firstLineParsed) {
-                    auto method = std::strtok(line.data(), kStatusSeparator);
-                    if (method == nullptr) {
+                    auto method = nextToken(line);
+                    if (method.empty()) {
                         PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid header format");
                     }
                     m_type = Type::kResponse;
@@ -108,38 +148,44 @@ namespace pd {
                             break;
                         }
                     }
-                    std::string version;
+                    std::string_view version;
                     if (m_type == Type::kRequest) {
-                        auto status = std::strtok(nullptr, kStatusSeparator);
-                        if (status == nullptr) {
+                        auto status = nextToken(line);
+                        if (status.empty()) {
                             PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid header format");
                         }
                         m_uri.m_url = status;
-                        version = std::strtok(nullptr, kStatusSeparator);
+                        version = nextToken(line);
                     } else {
                         version = method;
-                        std::string code = std::strtok(nullptr, kStatusSeparator);
-                        m_statusCode = code.empty() ? StatusCodes::kNone : static_cast<StatusCodes>(std::stoul(code));
+                        auto code = nextToken(line);
+                        unsigned long statusCode = 0;
+                        if (!code.empty() && std::from_chars(code.data(), code.data() + code.size(), statusCode).ec != std::errc{}) {
+                            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid status code");
+                        }
+                        m_statusCode = static_cast<StatusCodes>(statusCode);
                     }
-                    m_httpVersion = HttpVersion{version};
+                    m_httpVersion = HttpVersion{std::string{version}};
                     m_firstLineParsed = true;
                     return;
                 }
 
                 std::size_t pos = line.find(kFieldSeparator);
-                if (pos == std::string::npos) {
+                if (pos == std::string_view::npos) {
                     PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid header format");
                 }
-                std::string field = line.substr(0, pos);
-                std::string value = line.substr(pos + strlen(kFieldSeparator));
-                internal::trim(value);
+                auto field = line.substr(0, pos);
+                auto value = internal::trim(line.substr(pos + 1));
 
                 if (strcompci(field, kUserAgentTag)) {
                     m_userAgent = value;
                 } else if (strcompci(field, kHostTag)) {
-                    m_uri.m_address = Address(value);
+                    m_uri.m_address = Address(std::string{value});
                 } else if (strcompci(field, kContentLengthTag)) {
-                    m_contentLength = std::stoul(value);
+                    if (std::from_chars(value.data(), value.data() + value.size(), m_contentLength).ec != std::errc{}) {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid Content-Length");
+                    }
+                    m_hasContentLength = true;
                 } else if (strcompci(field, kContentTypeTag)) {
                     for (std::size_t i = 0; i < static_cast<std::size_t>(ContentType::kNumContextTypes); ++i) {
                         if (strcompci(value, kContentTypeStrs[i])) {
@@ -152,17 +198,75 @@ namespace pd {
                             m_contentTransferEncoding = static_cast<ContentTransferEncoding>(i);
                         }
                     }
+                } else if (strcompci(field, kTransferEncodingTag)) {
+                    // Chunked is always the last of the applied codings
+                    auto last = value.rfind(',');
+                    auto coding = internal::trim(value.substr(last == std::string_view::npos ? 0 : last + 1));
+                    m_chunked = strcompci(coding, kChunkedStr);
+                } else if (strcompci(field, kContentEncodingTag)) {
+                    if (strcompci(value, "gzip") || strcompci(value, "x-gzip")) {
+                        m_contentEncoding = ContentEncoding::kGzip;
+                    } else if (strcompci(value, "deflate")) {
+                        m_contentEncoding = ContentEncoding::kDeflate;
+                    } else if (strcompci(value, "identity")) {
+                        m_contentEncoding = ContentEncoding::kIdentity;
+                    } else {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unsupported content encoding " + std::string{value});
+                    }
+                } else if (strcompci(field, kConnectionTag)) {
+                    m_connectionClose = strcompci(value, "close");
+                    m_connectionKeepAlive = strcompci(value, "keep-alive");
+                } else if (strcompci(field, kAcceptRangesTag)) {
+                    m_acceptRanges = strcompci(value, kBytesUnit);
+                } else if (strcompci(field, kContentRangeTag) && m_type == Type::kResponse) {
+                    parseContentRange(value);
                 } else if (strcompci(field, kDateTag)) {
                     std::tm tm = {};
-                    std::stringstream sstream(value);
+                    std::stringstream sstream{std::string{value}};
                     sstream >> std::get_time(&tm, kDateTimeFormat);
                     m_dateTime = std::chrono::system_clock::from_time_t(std::mktime(&tm));
                 } else if ((strcompci(field, kCookieTag) && m_type == Type::kRequest) ||
                            (strcompci(field, kSetCookieTag) && m_type == Type::kResponse)) {
-                    parseCookies(value);
+                    parseCookies(std::string{value});
                 } else if (strcompci(field, kLocationTag) && m_type == Type::kResponse) {
                     m_location = value;
+                } else if ((strcompci(field, kETagTag) && m_type == Type::kResponse) ||
+                           (strcompci(field, kIfNoneMatchTag) && m_type == Type::kRequest)) {
+                    m_validators.etag = value;
+                } else if ((strcompci(field, kLastModifiedTag) && m_type == Type::kResponse) ||
+                           (strcompci(field, kIfModifiedSinceTag) && m_type == Type::kRequest)) {
+                    m_validators.lastModified = value;
+                }
+            }
+
+            void HttpMessage::parseContentRange(std::string_view value) {
+                // bytes <first>-<last>/<complete length or *>, or bytes */<complete length>
+                if (value.size() <= std::strlen(kBytesUnit) || !strcompci(value.substr(0, std::strlen(kBytesUnit)), kBytesUnit)) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid Content-Range");
                 }
+                value = internal::trim(value.substr(std::strlen(kBytesUnit)));
+                auto slash = value.find('/');
+                if (slash == std::string_view::npos) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid Content-Range");
+                }
+                auto range = value.substr(0, slash);
+                auto completeLength = value.substr(slash + 1);
+                if (completeLength != "*" &&
+                    std::from_chars(completeLength.data(), completeLength.data() + completeLength.size(), m_completeLength).ec != std::errc{}) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid Content-Range");
+                }
+                if (range == "*") {
+                    return;
+                }
+                auto dash = range.find('-');
+                ByteRange contentRange;
+                if (dash == std::string_view::npos ||
+                    std::from_chars(range.data(), range.data() + dash, contentRange.first).ec != std::errc{} ||
+                    std::from_chars(range.data() + dash + 1, range.data() + range.size(), contentRange.last).ec != std::errc{} ||
+                    contentRange.first > contentRange.last) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid Content-Range");
+                }
+                m_contentRange = contentRange;
             }
 
             void HttpMessage::parseCookies(const std::string &string) {
@@ -298,6 +402,30 @@ namespace pd {
                 stream << kUserAgentTag << ": " << message.m_userAgent;
                 stream << kStringSeparator;
 
+                if (message.m_type == HttpMessage::Type::kRequest) {
+                    if (message.m_range) {
+                        // A range of the compressed representation could not be decoded on its own
+                        stream << kRangeTag << ": " << kBytesUnit << "=" << message.m_range->first << "-" << message.m_range->last;
+                        stream << kStringSeparator;
+                        if (!message.m_range->ifRange.empty()) {
+                            stream << kIfRangeTag << ": " << message.m_range->ifRange;
+                            stream << kStringSeparator;
+                        }
+                    } else if (message.m_httpMethod != HttpMessage::Method::kHead) {
+                        // A HEAD response has no body to decode
+                        stream << kAcceptEncodingTag << ": " << kAcceptedEncodings;
+                        stream << kStringSeparator;
+                    }
+                    if (!message.m_validators.etag.empty()) {
+                        stream << kIfNoneMatchTag << ": " << message.m_validators.etag;
+                        stream << kStringSeparator;
+                    }
+                    if (!message.m_validators.lastModified.empty()) {
+                        stream << kIfModifiedSinceTag << ": " << message.m_validators.lastModified;
+                        stream << kStringSeparator;
+                    }
+                }
+
                 std::string encodedData = message.encodeData();
                 if (!encodedData.empty()) {
                     stream << kContentLengthTag << ": " << encodedData.size();
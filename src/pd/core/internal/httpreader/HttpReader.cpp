@@ -20,88 +20,149 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include <array>
-#include <cstring>
+#include <algorithm>
+#include <cassert>
 
 #include <pd/Exception.hpp>
 #include <pd/core/internal/httpreader/HttpReader.hpp>
+#include <pd/core/internal/httpreader/ReadBufferPool.hpp>
 
 namespace pd {
     namespace internal {
         namespace httpreader {
 
-            static const constexpr char kHeaderSeparator[] = "\r\n\r\n";
-            static const constexpr std::size_t kHeaderSeparatorSize = sizeof(kHeaderSeparator) - 1;
-            static const constexpr std::size_t kMaxHttpHeaderSize = 100 * 1024;
-            static const constexpr std::size_t kMaxHttpMessageSize = 100 * 1024 * 1024;
-
             void HttpReader::read(const StreamPtr &stream) {
                 assert(stream);
-                static const constexpr std::size_t kBufferSize = 10 * 1024;
-                std::array<char, kBufferSize> buffer{};
-                std::size_t count = stream->read(buffer.data(), kBufferSize);
+                // The body is passed on as pointers into the slab, so it is not copied again before parsing
+                auto slab = ReadBufferPool::instance().acquire();
+                std::size_t count = stream->read(slab.data(), slab.size());
 
-                assert(count <= kBufferSize);
+                assert(count <= slab.size());
 
-                if (count + m_readBuffer.size() > kMaxHttpMessageSize) {
-                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Too big message");
+                if (count == 0) {
+                    if (!m_headerParser.isComplete()) {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Connection closed before the end of the header");
+                    }
+                    // The peer has closed the connection: the end of a body without Content-Length
+                    m_closed = true;
+                    if ((m_httpMessage->m_hasContentLength && m_bodyLength < m_httpMessage->m_contentLength) ||
+                        (m_chunkedDecoder && !m_chunkedDecoder->isComplete())) {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Connection closed before the end of the message");
+                    }
+                    onMessageComplete();
+                    return;
                 }
 
-                if (count) {
-                    m_readBuffer.insert(m_readBuffer.end(), buffer.data(), buffer.data() + count);
-
-                    if (!m_headerFound) {
-                        m_headerFound = findHeader();
-                        if (!m_headerFound && m_readBuffer.size() > kMaxHttpHeaderSize) {
-                            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Too big header");
-                        }
+                m_received = true;
+                if (m_headerParser.isComplete()) {
+                    onBody(slab.data(), count);
+                } else {
+                    // The header is parsed straight from the read buffer, the rest of it is the beginning of the body
+                    std::size_t consumed = m_headerParser.parse(slab.data(), count);
+                    if (!m_headerParser.isComplete()) {
+                        return;
+                    }
+                    onHeader();
+                    if (consumed < count) {
+                        onBody(slab.data() + consumed, count - consumed);
                     }
                 }
 
-                if (m_totalLength > 0 && m_readBuffer.size() < m_totalLength) {
+                if (isBodyComplete()) {
+                    onMessageComplete();
+                }
+            }
+
+            bool HttpReader::isBodyComplete() const {
+                // Content-Length of a 304 or a HEAD response is the length of the body a GET would get
+                if (!hasBody()) {
+                    return true;
+                }
+                if (m_chunkedDecoder) {
+                    return m_chunkedDecoder->isComplete();
+                }
+                if (m_httpMessage->m_hasContentLength) {
+                    return m_bodyLength >= m_httpMessage->m_contentLength;
+                }
+                return false;
+            }
+
+            bool HttpReader::hasBody() const {
+                auto statusCode = static_cast<int>(m_httpMessage->m_statusCode);
+                return m_method != HttpMessage::Method::kHead && (statusCode < 100 || statusCode >= 200) &&
+                       m_httpMessage->m_statusCode != HttpMessage::StatusCodes::kNoContent &&
+                       m_httpMessage->m_statusCode != HttpMessage::StatusCodes::kNotModified;
+            }
+
+            void HttpReader::onHeader() {
+                m_httpMessage->m_headerSize = m_headerParser.headerSize();
+                m_redirect = m_httpMessage->m_statusCode == HttpMessage::StatusCodes::kTemporaryRedirect ||
+                             m_httpMessage->m_statusCode == HttpMessage::StatusCodes::kMovedPermanently;
+                if (!hasBody()) {
+                    // Transfer-Encoding and Content-Encoding describe the body a GET would get
                     return;
                 }
+                if (m_httpMessage->m_chunked) {
+                    m_chunkedDecoder = std::make_unique<ChunkedDecoder>();
+                }
+                if (m_httpMessage->m_contentEncoding != HttpMessage::ContentEncoding::kIdentity && !m_redirect) {
+                    m_inflater = std::make_unique<Inflater>(m_httpMessage->m_contentEncoding);
+                }
+            }
 
-                onMessageComplete();
+            void HttpReader::onBody(const char *data, std::size_t size) {
+                if (m_httpMessage->m_hasContentLength && !m_chunkedDecoder) {
+                    // Anything after the declared length does not belong to this message
+                    std::size_t rest = m_httpMessage->m_contentLength - m_bodyLength;
+                    m_overrun = m_overrun || size > rest;
+                    size = std::min(size, rest);
+                }
+                m_bodyLength += size;
+                if (size == 0) {
+                    return;
+                }
+                if (m_chunkedDecoder) {
+                    std::size_t consumed = m_chunkedDecoder->decode(data, size, [this](const char *chunk, std::size_t chunkSize) {
+                        onContent(chunk, chunkSize);
+                    });
+                    m_overrun = m_overrun || consumed < size;
+                } else {
+                    onContent(data, size);
+                }
             }
 
-            bool HttpReader::findHeader() {
-                for (std::size_t i = 0; i < m_readBuffer.size() - kHeaderSeparatorSize + 1; ++i) {
-                    if (kHeaderSeparator[0] == m_readBuffer.at(i)) {
-                        if (std::strncmp(kHeaderSeparator + 1, &m_readBuffer.at(i + 1), kHeaderSeparatorSize - 1) != 0) {
-                            continue;
-                        }
-                        std::size_t headerSize = i + 2;
-                        if (headerSize > kMaxHttpHeaderSize) {
-                            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Too big header");
-                        }
-                        std::string header;
-                        header.reserve(headerSize);
-                        std::copy(m_readBuffer.data(), m_readBuffer.data() + headerSize, std::back_inserter(header));
-                        m_httpMessage = std::make_unique<HttpMessage>(header);
-                        m_totalLength = m_httpMessage->m_contentLength + headerSize;
-                        if (m_totalLength > kMaxHttpMessageSize) {
-                            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Too big message");
-                        }
-                        return true;
-                    }
+            void HttpReader::onContent(const char *data, std::size_t size) {
+                if (m_redirect) {
+                    return;
+                }
+                if (m_inflater) {
+                    m_inflater->inflate(data, size, [this](const char *inflated, std::size_t inflatedSize) {
+                        deliver(inflated, inflatedSize);
+                    });
+                } else {
+                    deliver(data, size);
                 }
-                return false;
+            }
+
+            void HttpReader::deliver(const char *data, std::size_t size) {
+                if (m_httpMessage->m_contentType == HttpMessage::ContentType::kOctetStream &&
+                    m_httpMessage->m_contentTransferEncoding == HttpMessage::ContentTransferEncoding::kBase64) {
+                    m_encodedBody.append(data, size);
+                    return;
+                }
+                m_callback(data, size);
             }
 
             void HttpReader::onMessageComplete() {
-                // message is completely read, construct the message object and further process the message
-                std::string message(m_readBuffer.data(), m_readBuffer.size());
-                m_httpMessage = std::make_unique<HttpMessage>(message);
-                if (!m_httpMessage->isWellFormed()) {
-                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Message is malformed");
-                }
-                if (m_httpMessage->m_statusCode == HttpMessage::StatusCodes::kTemporaryRedirect ||
-                    m_httpMessage->m_statusCode == HttpMessage::StatusCodes::kMovedPermanently) {
+                if (m_inflater && !m_inflater->isComplete()) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Truncated compressed message");
+                }
+                if (m_redirect) {
                     m_redirectCallback(m_httpMessage->m_location);
-                } else {
+                } else if (!m_encodedBody.empty()) {
+                    m_httpMessage->decodeData(m_encodedBody);
                     const auto &data = m_httpMessage->getData();
-                    m_callback(data);
+                    m_callback(data.data(), data.size());
                 }
                 m_complete = true;
             }
@@ -57,6 +57,8 @@ namespace pd {
                 m_httpMessage->m_type = type;
                 m_httpMessage->m_statusCode = statusCode;
                 m_httpMessage->m_contentType = contentType;
+                m_httpMessage->m_range = m_range;
+                m_httpMessage->m_validators = m_validators;
                 if (contentType == HttpMessage::ContentType::kOctetStream) {
                     std::vector<char> v(text.size());
                     std::copy(text.begin(), text.end(), v.begin());
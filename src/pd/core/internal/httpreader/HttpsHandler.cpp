@@ -27,6 +27,7 @@ SOFTWARE.
 #endif
 
 #include <pd/Exception.hpp>
+#include <pd/core/internal/httpreader/ConnectionPool.hpp>
 #include <pd/core/internal/httpreader/Connector.hpp>
 #include <pd/core/internal/httpreader/HttpsHandler.hpp>
 
@@ -35,24 +36,58 @@ namespace pd {
     namespace internal {
         namespace httpreader {
             HttpsHandler::HttpsHandler(const std::string &userAgent,
-                                       const Uri &uri, const HttpReader::Callback &callback, const HttpReader::RedirectCallback &redirectCallback) {
-                m_sslStream = std::make_shared<SslStream>();
-
-                connect(m_sslStream, uri.m_address);
-                sslConnect(m_sslStream, uri.m_address);
+                                       const Uri &uri, const HttpReader::Callback &callback, const HttpReader::RedirectCallback &redirectCallback,
+                                       HttpMessage::Method method, const std::optional<ByteRange> &range, const CacheValidators &validators)
+                : m_uri{uri}, m_method{method} {
+                // The pool is keyed by scheme, so a connection taken for an https uri is always an SslStream
+                m_sslStream = std::static_pointer_cast<SslStream>(ConnectionPool::instance().acquire(uri));
+                m_reused = m_sslStream != nullptr;
+                if (!m_sslStream) {
+                    m_sslStream = std::make_shared<SslStream>();
+                    connect(m_sslStream, uri.m_address);
+                    sslConnect(m_sslStream, uri.m_address);
+                }
 
-                m_reader = std::make_unique<HttpReader>(callback, redirectCallback);
+                m_reader = std::make_unique<HttpReader>(callback, redirectCallback, method);
                 m_writer = std::make_unique<HttpWriter>(userAgent, uri);
+                if (range) {
+                    m_writer->setRange(*range);
+                }
+                m_writer->setValidators(validators);
 
-                m_writer->request();
+                m_writer->request(method);
                 m_mode = Mode::kWrite;
             }
 
             void HttpsHandler::handle(short revents) {
+                try {
+                    exchange(revents);
+                } catch (const std::exception &) {
+                    // The server may have closed an idle connection just as it was taken from the pool.
+                    // GET and HEAD are idempotent, so the request is sent once more over a new connection.
+                    bool idempotent = m_method == HttpMessage::Method::kGet || m_method == HttpMessage::Method::kHead;
+                    if (!m_reused || !idempotent || m_reader->hasReceived()) {
+                        throw;
+                    }
+                    m_reused = false;
+                    auto sslStream = std::make_shared<SslStream>();
+                    connect(sslStream, m_uri.m_address);
+                    sslConnect(sslStream, m_uri.m_address);
+                    m_sslStream = sslStream;
+                    m_mode = Mode::kWrite;
+                }
+            }
+
+            void HttpsHandler::exchange(short revents) {
                 if (revents & POLLIN) {
                     m_reader->read(m_sslStream);
                     if (m_reader->isReadComplete()) {
                         m_mode = Mode::kFinish;
+                        // After the response the session carries any tickets the server has issued
+                        saveSslSession(m_sslStream, m_uri.m_address);
+                        if (m_reader->isKeepAlive()) {
+                            ConnectionPool::instance().release(m_uri, m_sslStream);
+                        }
                         return;
                     }
                 }
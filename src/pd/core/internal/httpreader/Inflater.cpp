@@ -0,0 +1,113 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/httpreader/Inflater.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+            // 16 added to the window size makes zlib expect a gzip header
+            static const constexpr int kGzipWindowBits = MAX_WBITS + 16;
+            // Negative window size: raw deflate data without a zlib header
+            static const constexpr int kRawDeflateWindowBits = -MAX_WBITS;
+            // zlib checks its header once it has both bytes of it
+            static const constexpr std::size_t kZlibHeaderSize = 2;
+
+            Inflater::Inflater(HttpMessage::ContentEncoding encoding)
+                : m_encoding{encoding} {
+                init(encoding == HttpMessage::ContentEncoding::kGzip ? kGzipWindowBits : MAX_WBITS);
+            }
+
+            Inflater::~Inflater() {
+                if (m_initialized) {
+                    inflateEnd(&m_stream);
+                }
+            }
+
+            void Inflater::init(int windowBits) {
+                if (m_initialized) {
+                    inflateEnd(&m_stream);
+                    m_initialized = false;
+                }
+                m_stream = z_stream{};
+                if (inflateInit2(&m_stream, windowBits) != Z_OK) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot initialize zlib");
+                }
+                m_initialized = true;
+            }
+
+            void Inflater::inflate(const char *data, std::size_t size, const Callback &callback) {
+                // Before zlib has its whole header the body may still turn out to be raw deflate
+                std::size_t headerTaken = m_header.size();
+                bool mayBeRaw = m_encoding == HttpMessage::ContentEncoding::kDeflate && !m_raw && headerTaken < kZlibHeaderSize;
+                if (mayBeRaw) {
+                    m_header.append(data, std::min(size, kZlibHeaderSize - headerTaken));
+                }
+                std::string replayed;
+                // zlib does not modify the input despite the non-const pointer
+                m_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+                m_stream.avail_in = static_cast<uInt>(size);
+                // Output that did not fit into the buffer stays inside zlib until the next round
+                bool outputFull = false;
+                while (m_stream.avail_in > 0 || outputFull) {
+                    if (m_complete) {
+                        // A gzip body may consist of several members, other bodies end with their stream
+                        if (m_encoding != HttpMessage::ContentEncoding::kGzip) {
+                            break;
+                        }
+                        inflateReset(&m_stream);
+                        m_complete = false;
+                    }
+                    m_stream.next_out = reinterpret_cast<Bytef *>(m_output.data());
+                    m_stream.avail_out = static_cast<uInt>(m_output.size());
+                    int result = ::inflate(&m_stream, Z_NO_FLUSH);
+                    if (result == Z_DATA_ERROR && mayBeRaw) {
+                        // Some servers send "deflate" bodies without the zlib header: start over with
+                        // the bytes zlib took from earlier pieces
+                        init(kRawDeflateWindowBits);
+                        m_raw = true;
+                        mayBeRaw = false;
+                        replayed = m_header.substr(0, headerTaken) + std::string{data, size};
+                        m_stream.next_in = reinterpret_cast<Bytef *>(replayed.data());
+                        m_stream.avail_in = static_cast<uInt>(replayed.size());
+                        continue;
+                    }
+                    if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid compressed data: " + std::string{m_stream.msg ? m_stream.msg : ""});
+                    }
+                    std::size_t count = m_output.size() - m_stream.avail_out;
+                    if (count > 0) {
+                        callback(m_output.data(), count);
+                    }
+                    // The end of a stream comes with all of its output
+                    m_complete = result == Z_STREAM_END;
+                    outputFull = !m_complete && m_stream.avail_out == 0;
+                }
+            }
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
@@ -20,13 +20,18 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <algorithm>
 #include <vector>
 
 #ifdef _WIN32
 #include <Winsock2.h>
 #else
+#include <cerrno>
 #include <poll.h>
 #endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include <pd/Exception.hpp>
 #include <pd/core/internal/httpreader/Error.hpp>
@@ -39,66 +44,201 @@ static inline int poll(struct pollfd *pfd, int nfds, int timeout) { return WSAPo
 namespace pd {
     namespace internal {
         namespace httpreader {
-            static constexpr int kTimeout = 10000;
+            // The loop wakes up at least this often to check the stop flag
+            static constexpr int kMaxWaitTime = 1000;
+#ifdef __linux__
+            static constexpr int kMaxEvents = 256;
 
-            void Poll::run() {
-                std::vector<pollfd> fds(m_handlers.size());
+            static std::uint32_t toEpollEvents(short events) {
+                return ((events & POLLIN) ? EPOLLIN : 0u) | ((events & POLLOUT) ? EPOLLOUT : 0u);
+            }
 
-                while (!m_isStopped && !m_handlers.empty()) {
-                    std::size_t i = 0;
-                    for (const auto &handler: m_handlers) {
-                        if (m_isStopped) {
-                            return;
-                        }
-                        assert(handler);
-                        const auto &socket = handler->getSocket();
-                        if (!socket.isOpened()) {
-                            continue;
-                        }
+            static short fromEpollEvents(std::uint32_t events) {
+                return static_cast<short>(((events & EPOLLIN) ? POLLIN : 0) | ((events & EPOLLOUT) ? POLLOUT : 0) |
+                                          ((events & EPOLLERR) ? POLLERR : 0) | ((events & EPOLLHUP) ? POLLHUP : 0));
+            }
+#endif
 
-                        auto sock = socket.socket();
+            Poll::Poll(std::chrono::milliseconds timeout)
+                : m_timeout{timeout} {
+#ifdef __linux__
+                m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+                if (m_epoll == -1) {
+                    throwError();
+                }
+#endif
+            }
 
-                        fds[i].fd = sock;
-                        fds[i].events = handler->getEvents();
-                        ++i;
-                    }
-#ifdef _WIN32
-                    int res = ::poll(fds.data(), static_cast<int>(m_handlers.size()), kTimeout);
-#else
-                    int res = ::poll(fds.data(), m_handlers.size(), kTimeout);
+            Poll::~Poll() {
+#ifdef __linux__
+                // Sockets may outlive the loop in the connection pool, so they are unregistered explicitly
+                while (!m_entries.empty()) {
+                    remove(m_entries.begin());
+                }
+                ::close(m_epoll);
 #endif
+            }
 
-                    if (res == SOCKET_ERROR) {
+            void Poll::addHandler(HandlerPtr handler, std::chrono::milliseconds timeout) {
+                assert(handler && handler->getSocket().isOpened());
+                if (m_ids.count(handler.get()) != 0) {
+                    return;
+                }
+                Id id = m_nextId++;
+                m_ids.emplace(handler.get(), id);
+                auto socket = handler->getSocket().socket();
+                auto &entry = m_entries.emplace(id, Entry{std::move(handler), socket, 0, timeout, Clock::time_point{}}).first->second;
+                touch(id, entry);
+                watch(id, entry, true);
+            }
+
+            void Poll::removeHandler(const HandlerPtr &handler) {
+                auto id = m_ids.find(handler.get());
+                if (id != m_ids.end()) {
+                    remove(m_entries.find(id->second));
+                }
+            }
+
+            void Poll::remove(Entries::iterator it) {
+                auto &entry = it->second;
+#ifdef __linux__
+                if (entry.events != 0 && entry.handler->getSocket().isOpened() && entry.handler->getSocket().socket() == entry.socket) {
+                    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, entry.socket, nullptr);
+                }
+#endif
+                m_deadlines.erase({entry.deadline, it->first});
+                m_ids.erase(entry.handler.get());
+                m_entries.erase(it);
+            }
+
+            void Poll::touch(Id id, Entry &entry) {
+                m_deadlines.erase({entry.deadline, id});
+                entry.deadline = Clock::now() + entry.timeout;
+                m_deadlines.emplace(entry.deadline, id);
+            }
+
+            void Poll::watch(Id id, Entry &entry, bool added) {
+                short events = entry.handler->getEvents();
+                auto socket = entry.handler->getSocket().socket();
+                if (!added && socket != entry.socket) {
+                    // The handler has reconnected: the old socket is closed, which has also unregistered it
+                    entry.socket = socket;
+                    entry.events = 0;
+                    added = true;
+                }
+                if (!added && events == entry.events) {
+                    return;
+                }
+#ifdef __linux__
+                bool registered = !added && entry.events != 0;
+                int operation = !registered ? EPOLL_CTL_ADD : events == 0 ? EPOLL_CTL_DEL
+                                                                          : EPOLL_CTL_MOD;
+                if (registered || events != 0) {
+                    epoll_event event{};
+                    event.events = toEpollEvents(events);
+                    event.data.u64 = id;
+                    if (::epoll_ctl(m_epoll, operation, entry.handler->getSocket().socket(), &event) == -1) {
                         throwError();
-                    } else if (res == 0) {
-                        continue;
                     }
+                }
+#else
+                (void) id;
+#endif
+                entry.events = events;
+            }
 
-                    i = 0;
-                    for (const auto &handler: m_handlers) {
-                        if (m_isStopped) {
-                            return;
-                        }
-                        assert(handler);
-                        const auto &socket = handler->getSocket();
-                        if (!socket.isOpened()) {
+            int Poll::waitTime() const {
+                if (m_deadlines.empty()) {
+                    return kMaxWaitTime;
+                }
+                auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(m_deadlines.begin()->first - Clock::now()).count() + 1;
+                return static_cast<int>(std::clamp<long long>(wait, 0, kMaxWaitTime));
+            }
+
+            void Poll::expireTimers() {
+                if (!m_deadlines.empty() && m_deadlines.begin()->first <= Clock::now()) {
+                    remove(m_entries.find(m_deadlines.begin()->second));
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Connection timed out");
+                }
+            }
+
+            void Poll::dispatch(Id id, short revents) {
+                auto it = m_entries.find(id);
+                if (it == m_entries.end()) {
+                    // Removed by a handler dispatched earlier in the same wakeup
+                    return;
+                }
+                auto handler = it->second.handler;
+                if (revents & (POLLERR | POLLHUP)) {
+                    // Let the handler run into the error on its next read or write
+                    revents |= it->second.events;
+                }
+                if ((revents & it->second.events) == 0) {
+                    return;
+                }
+                handler->handle(revents);
+
+                // The handler may have changed the loop
+                it = m_entries.find(id);
+                if (it == m_entries.end()) {
+                    return;
+                }
+                if (handler->isFinished()) {
+                    remove(it);
+                    return;
+                }
+                touch(id, it->second);
+                watch(id, it->second, false);
+            }
+
+            void Poll::run() {
+#ifdef __linux__
+                std::vector<epoll_event> events(kMaxEvents);
+                while (!m_isStopped && !m_entries.empty()) {
+                    int count = ::epoll_wait(m_epoll, events.data(), kMaxEvents, waitTime());
+                    if (count == -1) {
+                        if (errno == EINTR) {
                             continue;
                         }
-
-                        if (fds[i].revents & handler->getEvents()) {
-                            handler->handle(fds[i].revents);
-                            fds[i].revents = 0;
+                        throwError();
+                    }
+                    for (int i = 0; i < count && !m_isStopped; ++i) {
+                        dispatch(events[i].data.u64, fromEpollEvents(events[i].events));
+                    }
+                    expireTimers();
+                }
+#else
+                std::vector<pollfd> fds;
+                std::vector<Id> ids;
+                while (!m_isStopped && !m_entries.empty()) {
+                    fds.clear();
+                    ids.clear();
+                    for (const auto &[id, entry]: m_entries) {
+                        if (entry.events == 0) {
+                            continue;
                         }
-                        ++i;
+                        pollfd fd{};
+                        fd.fd = entry.handler->getSocket().socket();
+                        fd.events = entry.events;
+                        fds.push_back(fd);
+                        ids.push_back(id);
                     }
-
-                    auto handlers{m_handlers};
-                    for (const auto &handler: handlers) {
-                        if (handler->isFinished()) {
-                            removeHandler(handler);
+#ifdef _WIN32
+                    int res = ::poll(fds.data(), static_cast<int>(fds.size()), waitTime());
+#else
+                    int res = ::poll(fds.data(), fds.size(), waitTime());
+#endif
+                    if (res == SOCKET_ERROR) {
+                        throwError();
+                    }
+                    for (std::size_t i = 0; i < fds.size() && res > 0 && !m_isStopped; ++i) {
+                        if (fds[i].revents != 0) {
+                            dispatch(ids[i], fds[i].revents);
                         }
                     }
+                    expireTimers();
                 }
+#endif
             }
         }// namespace httpreader
     }// namespace internal
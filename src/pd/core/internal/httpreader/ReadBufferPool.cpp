@@ -0,0 +1,54 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pd/core/internal/httpreader/ReadBufferPool.hpp>
+
+namespace pd {
+    namespace internal {
+        namespace httpreader {
+            ReadBufferPool &ReadBufferPool::instance() {
+                static ReadBufferPool pool;
+                return pool;
+            }
+
+            ReadBufferPool::Slab ReadBufferPool::acquire() {
+                {
+                    std::lock_guard lock{m_mutex};
+                    if (!m_free.empty()) {
+                        auto data = std::move(m_free.back());
+                        m_free.pop_back();
+                        return Slab{this, std::move(data)};
+                    }
+                }
+                // Not value-initialized: the slab is always written before it is read
+                return Slab{this, std::unique_ptr<char[]>{new char[kSlabSize]}};
+            }
+
+            void ReadBufferPool::release(std::unique_ptr<char[]> data) {
+                std::lock_guard lock{m_mutex};
+                if (m_free.size() < kMaxFreeSlabs) {
+                    m_free.push_back(std::move(data));
+                }
+            }
+        }// namespace httpreader
+    }// namespace internal
+}// namespace pd
@@ -22,6 +22,11 @@ SOFTWARE.
 
 #ifdef OPENSSL
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include <pd/Exception.hpp>
 #include <pd/core/internal/httpreader/Connector.hpp>
 #include <pd/core/internal/httpreader/SslConnector.hpp>
@@ -29,10 +34,45 @@ SOFTWARE.
 namespace pd {
     namespace internal {
         namespace httpreader {
+            using SslSessionPtr = std::unique_ptr<SSL_SESSION, decltype(&SSL_SESSION_free)>;
+
+            struct SslSessions {
+                std::mutex mutex;
+                std::unordered_map<std::string, SslSessionPtr> sessions;
+            };
+
+            // Never destroyed, like the SSL context: freeing the sessions at exit would run after OpenSSL has cleaned up
+            static SslSessions &sslSessions() {
+                static auto *sessions = new SslSessions;
+                return *sessions;
+            }
+
+            static std::string sessionKey(const Address &address) {
+                return address.ipAddressOrName() + ":" + std::to_string(address.port());
+            }
+
             void sslConnect(const SslStreamPtr &stream, const Address &address) {
                 stream->setHost(address.ipAddressOrName());
+                {
+                    auto &cache = sslSessions();
+                    std::lock_guard lock{cache.mutex};
+                    auto it = cache.sessions.find(sessionKey(address));
+                    if (it != cache.sessions.end()) {
+                        stream->setSession(it->second.get());
+                    }
+                }
                 stream->connect();
             }
+
+            void saveSslSession(const SslStreamPtr &stream, const Address &address) {
+                SslSessionPtr session{stream->getSession(), &SSL_SESSION_free};
+                if (!session) {
+                    return;
+                }
+                auto &cache = sslSessions();
+                std::lock_guard lock{cache.mutex};
+                cache.sessions.insert_or_assign(sessionKey(address), std::move(session));
+            }
         }// namespace httpreader
     }// namespace internal
 }// namespace pd
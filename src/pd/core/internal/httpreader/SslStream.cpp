@@ -22,6 +22,16 @@ SOFTWARE.
 
 #ifdef OPENSSL
 
+#ifdef _WIN32
+#include <Winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 
@@ -29,18 +39,35 @@ SOFTWARE.
 #include <pd/core/internal/httpreader/Error.hpp>
 #include <pd/core/internal/httpreader/SslStream.hpp>
 
+#ifdef _WIN32
+static inline int poll(struct pollfd *pfd, int nfds, int timeout) { return WSAPoll(pfd, nfds, timeout); }
+#endif
+
 namespace pd {
     namespace internal {
         namespace httpreader {
+            static std::atomic<std::uint64_t> readBytes{0};
+            static std::atomic<std::uint64_t> readCalls{0};
+            static std::atomic<std::int64_t> readNanoseconds{0};
+
+            // One client context for all connections: creating it is expensive and sessions are only
+            // resumed within the context they were established in
+            static SSL_CTX *clientContext() {
+                static SSL_CTX *context = []() {
+                    SSL_CTX *ctx = SSL_CTX_new(TLS_client_method());
+                    if (ctx == nullptr) {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Can't create SSL context");
+                    }
+                    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT);
+                    return ctx;
+                }();
+                return context;
+            }
+
             void SslStream::open() {
                 Stream::open();
 
-                const SSL_METHOD *method = TLS_client_method();
-                m_ctx = SSL_CTX_new(method);
-                if (m_ctx == nullptr) {
-                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Can't create SSL context");
-                }
-                m_ssl = SSL_new(m_ctx);
+                m_ssl = SSL_new(clientContext());
                 if (m_ssl == nullptr) {
                     PD_THROW_WITH_STACKTRACE(std::runtime_error, "Can't create SSL");
                 }
@@ -56,6 +83,21 @@ namespace pd {
                 }
             }
 
+            void SslStream::setSession(SSL_SESSION *session) {
+                if (SSL_set_session(m_ssl, session) != 1) {
+                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot set SSL session");
+                }
+            }
+
+            SSL_SESSION *SslStream::getSession() const {
+                SSL_SESSION *session = SSL_get1_session(m_ssl);
+                if (session != nullptr && SSL_SESSION_is_resumable(session) != 1) {
+                    SSL_SESSION_free(session);
+                    return nullptr;
+                }
+                return session;
+            }
+
             void SslStream::connect() {
 #ifdef _WIN32
                 int sock = static_cast<int>(getSocket().socket());
@@ -88,17 +130,62 @@ namespace pd {
             }
 
             void SslStream::close() {
+                // Freed without a shutdown, OpenSSL takes the session for broken and no longer resumes it.
+                // The close alert itself is not sent: the peer may already be gone
+                if (m_ssl != nullptr && SSL_is_init_finished(m_ssl)) {
+                    SSL_set_shutdown(m_ssl, SSL_SENT_SHUTDOWN);
+                }
                 SSL_free(m_ssl);
-                SSL_CTX_free(m_ctx);
+                m_ssl = nullptr;
                 Stream::close();
             }
 
             std::size_t SslStream::read(void *buffer, std::size_t count) const {
-                int readSize = SSL_read(m_ssl, buffer, static_cast<int>(count));
-                if (readSize < 0) {
-                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Error receiving message");
-                }
-                return readSize;
+                auto *data = static_cast<char *>(buffer);
+                auto start = std::chrono::steady_clock::now();
+                std::size_t total = 0;
+                std::uint64_t calls = 0;
+                // A record is read only into room for all of it: decrypted bytes left inside OpenSSL would
+                // not make the socket readable, so the event loop would never come back for them
+                do {
+                    int readSize = SSL_read(m_ssl, data + total, static_cast<int>(std::min<std::size_t>(count - total, INT_MAX)));
+                    ++calls;
+                    if (readSize < 0 && total == 0) {
+                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Error receiving message");
+                    }
+                    if (readSize <= 0) {
+                        // An error after some data is reported by the next read
+                        break;
+                    }
+                    total += static_cast<std::size_t>(readSize);
+                } while (count - total >= SSL3_RT_MAX_PLAIN_LENGTH && isReadable());
+
+                readBytes.fetch_add(total, std::memory_order_relaxed);
+                readCalls.fetch_add(calls, std::memory_order_relaxed);
+                readNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+                                          std::memory_order_relaxed);
+                return total;
+            }
+
+            bool SslStream::isReadable() const {
+                pollfd fd{};
+                fd.fd = getSocket().socket();
+                fd.events = POLLIN;
+                return ::poll(&fd, 1, 0) > 0;
+            }
+
+            TlsReadStatistics SslStream::readStatistics() {
+                TlsReadStatistics statistics;
+                statistics.bytes = readBytes.load(std::memory_order_relaxed);
+                statistics.calls = readCalls.load(std::memory_order_relaxed);
+                statistics.time = std::chrono::nanoseconds{readNanoseconds.load(std::memory_order_relaxed)};
+                return statistics;
+            }
+
+            void SslStream::resetReadStatistics() {
+                readBytes = 0;
+                readCalls = 0;
+                readNanoseconds = 0;
             }
 
             std::size_t SslStream::write(const void *buffer, std::size_t count) const {
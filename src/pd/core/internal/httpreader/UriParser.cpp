@@ -48,11 +48,12 @@ namespace pd {
                         std::size_t urlPos = uri.find('/', schemeLen);
                         std::string host = uri.substr(schemeLen, urlPos - schemeLen);
                         std::uint16_t port = schemeStr.m_port;
-                        std::size_t portPos = uri.find(':', urlPos);
+                        std::size_t portPos = host.find(':');
                         if (portPos != std::string::npos) {
-                            port = static_cast<std::uint16_t>(std::stoi(uri.substr(portPos + 1)));
+                            port = static_cast<std::uint16_t>(std::stoi(host.substr(portPos + 1)));
+                            host.resize(portPos);
                         }
-                        retUri.m_url = uri.substr(urlPos);
+                        retUri.m_url = urlPos == std::string::npos ? "/" : uri.substr(urlPos);
                         retUri.m_address = Address(port, host);
                         return retUri;
                     }
@@ -20,16 +20,32 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
 #include <pd/Exception.hpp>
+#include <pd/core/internal/Factorize.hpp>
 #include <pd/core/internal/Indexing.hpp>
+#include <pd/core/internal/LinearAlgebra.hpp>
+#include <pd/core/internal/Lookup.hpp>
+#include <pd/core/internal/Parallel.hpp>
+#include <pd/core/internal/Reduction.hpp>
+#include <pd/core/internal/Scan.hpp>
+#include <pd/core/internal/Take.hpp>
 #include <pd/core/series/Series/Series.hpp>
 
 namespace pd {
+    static internal::Index makeIndex(const std::vector<internal::Value> &index, np::Size size) {
+        return index.empty() ? internal::Index{size} : internal::Index{index};
+    }
 
     Series::Series(const internal::Array &data,
                    const std::vector<internal::Value> &index,
                    const internal::Value &name)
-        : m_data{data}, m_index{index, data.size()}, m_name{name} {
+        : m_data{data}, m_index{makeIndex(index, data.size())}, m_name{name} {
         np::Shape shape = m_data.shape();
         if (shape.size() != 1) {
             PD_THROW_WITH_STACKTRACE(std::runtime_error, "Only 1D arrays supported");
@@ -44,7 +60,7 @@ namespace pd {
     Series::Series(internal::Array &&data,
                    const std::vector<internal::Value> &index,
                    const internal::Value &name)
-        : m_data{std::move(data)}, m_index{index, data.size()}, m_name{name} {
+        : m_data{std::move(data)}, m_index{makeIndex(index, m_data.size())}, m_name{name} {
         np::Shape shape = m_data.shape();
         if (shape.size() != 1) {
             PD_THROW_WITH_STACKTRACE(std::runtime_error, "Only 1D arrays supported");
@@ -226,25 +242,25 @@ namespace pd {
             const auto &element = iloc(i);
             if (element.isBool()) {
                 auto array = np::Array<np::bool_>{*static_cast<const np::bool_ *>(element)};
-                return Series{array, m_name};
+                return Series{std::move(array), m_name};
             } else if (element.isIntC()) {
                 auto array = np::Array<np::intc>{*static_cast<const np::intc *>(element)};
-                return Series{array, m_name};
+                return Series{std::move(array), m_name};
             } else if (element.isInt()) {
                 auto array = np::Array<np::int_>{*static_cast<const np::int_ *>(element)};
-                return Series{array, m_name};
+                return Series{std::move(array), m_name};
             } else if (element.isSize()) {
                 auto array = np::Array<np::Size>{*static_cast<const np::Size *>(element)};
-                return Series{array, m_name};
+                return Series{std::move(array), m_name};
             } else if (element.isFloat()) {
                 auto array = np::Array<np::float_>{*static_cast<const np::float_ *>(element)};
-                return Series{array, m_name};
+                return Series{std::move(array), m_name};
             } else if (element.isString()) {
                 auto array = np::Array<np::string_>{*static_cast<const np::string_ *>(element)};
-                return Series{array, m_name};
+                return Series{std::move(array), m_name};
             } else if (element.isUnicode()) {
                 auto array = np::Array<np::unicode_>{*static_cast<const np::unicode_ *>(element)};
-                return Series{array, m_name};
+                return Series{std::move(array), m_name};
             } else {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid value type");
             }
@@ -336,338 +352,356 @@ namespace pd {
     }
 
     Series Series::iloc(const std::vector<bool> &indexes) const {
-        auto shape{m_shape};
         if (indexes.size() != size()) {
             PD_THROW_WITH_STACKTRACE(std::runtime_error, "Incorrect range");
         }
 
-        if (dtype() == "float64") {
-            np::Array<np::float_> array{shape};
-            for (np::Size j = 0; j < indexes.size(); ++j) {
-                const auto &value = at(indexes[j]);
-                array.set(j, *static_cast<const np::float_ *>(value));
-            }
-            return {array, m_name};
-        } else if (dtype() == "int") {
-            np::Array<np::intc> array{shape};
-            for (np::Size j = 0; j < indexes.size(); ++j) {
-                const auto &value = at(indexes[j]);
-                array.set(j, *static_cast<const np::intc *>(value));
-            }
-            return {array, m_name};
-        } else if (dtype() == "int64") {
-            np::Array<np::int_> array{shape};
-            for (np::Size j = 0; j < indexes.size(); ++j) {
-                const auto &value = at(indexes[j]);
-                array.set(j, *static_cast<const np::int_ *>(value));
-            }
-            return {array, m_name};
-        } else if (dtype() == "uint64") {
-            np::Array<np::Size> array{shape};
-            for (np::Size j = 0; j < indexes.size(); ++j) {
-                const auto &value = at(indexes[j]);
-                array.set(j, *static_cast<const np::Size *>(value));
+        std::vector<np::Size> rows;
+        for (np::Size j = 0; j < indexes.size(); ++j) {
+            if (indexes[j]) {
+                rows.push_back(j);
             }
-            return {array, m_name};
-        } else if (dtype() == "str") {
-            np::Array<np::string_> array{shape};
-            for (np::Size j = 0; j < indexes.size(); ++j) {
-                const auto &value = at(indexes[j]);
-                array.set(j, *static_cast<const np::string_ *>(value));
+        }
+        return take(rows);
+    }
+
+    static internal::Moments calculateMoments(const internal::Array &data) {
+        if (!internal::isNumeric(data)) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot calculate moments of a non-number array");
+        }
+        return internal::moments(data);
+    }
+
+    np::float_ Series::mean(bool skipna) const {
+        // An empty object series has always had a mean of 0, unlike the typed ones
+        if (m_data.isValueArray() && m_data.size() == 0) {
+            return 0;
+        }
+        auto moments = calculateMoments(m_data);
+        if ((!skipna && moments.hasNaN) || moments.count == 0) {
+            return std::numeric_limits<np::float_>::quiet_NaN();
+        }
+        return moments.mean;
+    }
+
+    np::float_ Series::std_(bool skipna) const {
+        return std::sqrt(var(skipna));
+    }
+
+    np::float_ Series::var(bool skipna) const {
+        auto moments = calculateMoments(m_data);
+        if (!skipna && moments.hasNaN) {
+            return std::numeric_limits<np::float_>::quiet_NaN();
+        }
+        return moments.variance();
+    }
+
+    Series Series::describe() const {
+        auto moments = calculateMoments(m_data);
+        np::Array<np::float_> result{np::Shape{5}};
+        result.set(0, static_cast<np::float_>(moments.count));
+        result.set(1, moments.count == 0 ? std::numeric_limits<np::float_>::quiet_NaN() : moments.mean);
+        result.set(2, std::sqrt(moments.variance()));
+        result.set(3, moments.count == 0 ? std::numeric_limits<np::float_>::quiet_NaN() : moments.min);
+        result.set(4, moments.count == 0 ? std::numeric_limits<np::float_>::quiet_NaN() : moments.max);
+        return Series{std::move(result), std::vector<internal::Value>{"count", "mean", "std", "min", "max"}, m_name};
+    }
+
+    // Places the elements of the given sorted ranks of [begin, end) at their sorted positions
+    static void selectRanks(std::vector<np::float_> &values, np::Size begin, np::Size end,
+                            std::vector<np::Size>::const_iterator ranksBegin, std::vector<np::Size>::const_iterator ranksEnd) {
+        if (ranksBegin == ranksEnd || end - begin <= 1) {
+            return;
+        }
+        auto middle = ranksBegin + (ranksEnd - ranksBegin) / 2;
+        auto rank = *middle;
+        std::nth_element(values.begin() + static_cast<std::ptrdiff_t>(begin), values.begin() + static_cast<std::ptrdiff_t>(rank),
+                         values.begin() + static_cast<std::ptrdiff_t>(end));
+        selectRanks(values, begin, rank, ranksBegin, middle);
+        selectRanks(values, rank + 1, end, middle + 1, ranksEnd);
+    }
+
+    static std::vector<np::float_> exactQuantiles(const internal::Array &data, const std::vector<np::float_> &q) {
+        std::vector<np::float_> values;
+        values.reserve(data.size());
+        np::float_ block[internal::kBlockSize];
+        for (np::Size row = 0; row < data.size(); row += internal::kBlockSize) {
+            auto count = std::min(internal::kBlockSize, data.size() - row);
+            internal::loadBlock(data, row, count, block);
+            for (np::Size i = 0; i < count; ++i) {
+                if (!std::isnan(block[i])) {
+                    values.push_back(block[i]);
+                }
             }
-            return {array, m_name};
-        } else if (dtype() == "unicode") {
-            np::Array<np::unicode_> array{shape};
-            for (np::Size j = 0; j < indexes.size(); ++j) {
-                const auto &value = at(indexes[j]);
-                array.set(j, *static_cast<const np::unicode_ *>(value));
+        }
+
+        std::vector<np::float_> result(q.size(), std::numeric_limits<np::float_>::quiet_NaN());
+        if (values.empty()) {
+            return result;
+        }
+
+        auto n = static_cast<np::Size>(values.size());
+        std::vector<np::Size> ranks;
+        for (auto quantile: q) {
+            auto position = quantile * static_cast<np::float_>(n - 1);
+            ranks.push_back(static_cast<np::Size>(std::floor(position)));
+            ranks.push_back(static_cast<np::Size>(std::ceil(position)));
+        }
+        std::sort(ranks.begin(), ranks.end());
+        ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+        selectRanks(values, 0, n, ranks.cbegin(), ranks.cend());
+
+        for (std::size_t i = 0; i < q.size(); ++i) {
+            auto position = q[i] * static_cast<np::float_>(n - 1);
+            auto lower = static_cast<np::Size>(std::floor(position));
+            auto upper = static_cast<np::Size>(std::ceil(position));
+            result[i] = values[lower] + (values[upper] - values[lower]) * (position - static_cast<np::float_>(lower));
+        }
+        return result;
+    }
+
+    np::float_ Series::quantile(np::float_ q, QuantileMethod method) const {
+        return static_cast<np::float_>(quantile(std::vector<np::float_>{q}, method).at(0));
+    }
+
+    Series Series::quantile(const std::vector<np::float_> &q, QuantileMethod method) const {
+        if (!internal::isNumeric(m_data)) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot calculate quantiles of a non-number array");
+        }
+        for (auto quantile: q) {
+            if (!(quantile >= 0.0 && quantile <= 1.0)) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Quantile must be between 0 and 1");
             }
-            return {array, m_name};
+        }
+
+        std::vector<np::float_> quantiles;
+        if (method == QuantileMethod::kExact) {
+            quantiles = exactQuantiles(m_data, q);
         } else {
-            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
+            auto digest = tdigest();
+            for (auto quantile: q) {
+                quantiles.push_back(digest.quantile(quantile));
+            }
         }
+
+        np::Array<np::float_> result{np::Shape{static_cast<np::Size>(q.size())}};
+        std::vector<internal::Value> index;
+        for (std::size_t i = 0; i < q.size(); ++i) {
+            result.set(static_cast<np::Size>(i), quantiles[i]);
+            index.emplace_back(q[i]);
+        }
+        return Series{std::move(result), index, m_name};
     }
 
-    static np::float_ mean_(const np::Array<internal::Value> &array) {
-        auto s = array.size();
-        if (s == 0)
-            return 0;
-        np::float_ result{};
-        for (np::Size i = 0; i < s; ++i) {
-            const auto &element = array.get(i);
-            if (element.isInt()) {
-                result += static_cast<np::int_>(element);
-            } else if (element.isIntC()) {
-                result += static_cast<np::intc>(element);
-            } else if (element.isFloat()) {
-                result += static_cast<np::float_>(element);
-            } else if (element.isSize()) {
-                result += static_cast<np::Size>(element);
-            } else {
-                continue;
+    np::float_ Series::median(QuantileMethod method) const {
+        return quantile(0.5, method);
+    }
+
+    internal::TDigest Series::tdigest(np::float_ compression) const {
+        if (!internal::isNumeric(m_data)) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot build a t-digest of a non-number array");
+        }
+        static const constexpr np::Size kMinRowsPerThread = 1 << 16;
+        std::vector<internal::TDigest> partial(internal::chunkCount(m_size, kMinRowsPerThread), internal::TDigest{compression});
+        internal::parallelFor(m_size, kMinRowsPerThread, [&](np::Size chunk, np::Size begin, np::Size end) {
+            np::float_ block[internal::kBlockSize];
+            for (np::Size row = begin; row < end; row += internal::kBlockSize) {
+                auto count = std::min(internal::kBlockSize, end - row);
+                internal::loadBlock(m_data, row, count, block);
+                partial[chunk].add(block, count);
             }
+        });
+        internal::TDigest result{compression};
+        for (const auto &digest: partial) {
+            result.merge(digest);
         }
-        np::float_ resultDiv{};
-        np::ndarray::internal::divide(result, s, resultDiv);
-        return resultDiv;
+        return result;
     }
 
-    static np::float_ nanmean_(const np::Array<internal::Value> &array) {
-        auto s = array.size();
-        if (s == 0)
-            return 0;
-        np::float_ result{};
-        np::Size count = 0;
-        for (np::Size i = 0; i < s; ++i) {
-            const auto &element = array.get(i);
-            bool isNaNResult{};
-            np::ndarray::internal::isNaN(element, isNaNResult);
-            if (isNaNResult)
-                continue;
-            if (element.isInt()) {
-                np::ndarray::internal::add(result, static_cast<np::int_>(element));
-            } else if (element.isIntC()) {
-                np::ndarray::internal::add(result, static_cast<np::intc>(element));
-            } else if (element.isFloat()) {
-                np::ndarray::internal::add(result, static_cast<np::float_>(element));
-            } else if (element.isSize()) {
-                np::ndarray::internal::add(result, static_cast<np::Size>(element));
-            } else {
-                continue;
+    Rolling<Series> Series::rolling(np::Size window) const {
+        return Rolling<Series>{*this, window, window};
+    }
+
+    Rolling<Series> Series::rolling(np::Size window, np::Size minPeriods) const {
+        return Rolling<Series>{*this, window, minPeriods};
+    }
+
+    Expanding<Series> Series::expanding(np::Size minPeriods) const {
+        return Expanding<Series>{*this, minPeriods};
+    }
+
+    Series Series::cumsum() const {
+        return Series{internal::scan(m_data, internal::ScanFunction::kSum), m_index.labels(), m_name};
+    }
+
+    Series Series::cumprod() const {
+        return Series{internal::scan(m_data, internal::ScanFunction::kProduct), m_index.labels(), m_name};
+    }
+
+    Series Series::cummin() const {
+        return Series{internal::scan(m_data, internal::ScanFunction::kMin), m_index.labels(), m_name};
+    }
+
+    Series Series::cummax() const {
+        return Series{internal::scan(m_data, internal::ScanFunction::kMax), m_index.labels(), m_name};
+    }
+
+    Series Series::diff(np::int_ periods) const {
+        return Series{internal::diff(m_data, periods), m_index.labels(), m_name};
+    }
+
+    Series Series::shift(np::int_ periods) const {
+        return Series{internal::shift(m_data, periods), m_index.labels(), m_name};
+    }
+
+    Series Series::take(const std::vector<np::Size> &rows) const {
+        // Named row labels follow their rows, a range index starts over
+        const auto &labels = m_index.labels();
+        if (labels.empty()) {
+            return Series{internal::take(m_data, rows), m_name};
+        }
+        std::vector<internal::Value> taken;
+        taken.reserve(rows.size());
+        for (auto row: rows) {
+            taken.push_back(labels[row]);
+        }
+        return Series{internal::take(m_data, rows), taken, m_name};
+    }
+
+    Series Series::value_counts(bool dropna) const {
+        auto factorization = internal::factorize(m_data);
+        std::vector<np::Size> order;
+        for (np::Size id = 0; id < factorization.counts.size(); ++id) {
+            if (!dropna || id != factorization.nanCode) {
+                order.push_back(id);
             }
-            ++count;
         }
-        np::float_ resultDiv{};
-        np::ndarray::internal::divide(result, count, resultDiv);
-        return resultDiv;
+        std::stable_sort(order.begin(), order.end(), [&factorization](np::Size id1, np::Size id2) {
+            return factorization.counts[id1] > factorization.counts[id2];
+        });
+
+        Series values{internal::take(factorization.uniques, order)};
+        np::Array<np::int_> counts{np::Shape{static_cast<np::Size>(order.size())}};
+        std::vector<internal::Value> index;
+        index.reserve(order.size());
+        for (np::Size i = 0; i < order.size(); ++i) {
+            counts.set(i, static_cast<np::int_>(factorization.counts[order[i]]));
+            index.push_back(values.at(i));
+        }
+        return Series{std::move(counts), index, m_name};
     }
 
-    np::float_ Series::mean(bool skipna) const {
-        if (m_data.isIntCArray()) {
-            const auto *array = static_cast<const np::Array<np::intc> *>(m_data);
-            if (skipna)
-                return array->nanmean();
-            else
-                return array->mean();
-        } else if (m_data.isIntArray()) {
-            const auto *array = static_cast<const np::Array<np::int_> *>(m_data);
-            if (skipna)
-                return array->nanmean();
-            else
-                return array->mean();
-        } else if (m_data.isSizeArray()) {
-            const auto *array = static_cast<const np::Array<np::Size> *>(m_data);
-            if (skipna)
-                return array->nanmean();
-            else
-                return array->mean();
-        } else if (m_data.isFloatArray()) {
-            const auto *array = static_cast<const np::Array<np::float_> *>(m_data);
-            if (skipna)
-                return array->nanmean();
-            else
-                return array->mean();
-        } else if (m_data.isValueArray()) {
-            const auto *array = static_cast<const np::Array<internal::Value> *>(m_data);
-            if (skipna)
-                return nanmean_(*array);
-            else
-                return mean_(*array);
+    Series Series::unique() const {
+        return Series{internal::factorize(m_data).uniques, m_name};
+    }
+
+    np::Size Series::nunique(bool dropna) const {
+        auto factorization = internal::factorize(m_data);
+        auto count = static_cast<np::Size>(factorization.counts.size());
+        return dropna && factorization.nanCode != internal::HashTable<np::int_>::kNotFound ? count - 1 : count;
+    }
+
+    template<typename DType>
+    static bool isNaNValue(const DType &value) {
+        if constexpr (std::is_floating_point_v<DType>) {
+            return std::isnan(value);
+        } else if constexpr (std::is_same_v<DType, internal::Value>) {
+            return value.isFloat() && std::isnan(static_cast<np::float_>(value));
         } else {
-            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot calculate mean of a non-number array");
+            return false;
         }
     }
 
-    static np::float_ std__(const np::Array<internal::Value> &array) {
-        np::ndarray::array_dynamic::NDArrayDynamic<np::float_> x;
-        np::float_ m = mean_(array);
-        for (np::Size i = 0; i < array.size(); ++i) {
-            const auto &element = array.get(i);
-            np::float_ result;
-            if (element.isInt()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isIntC()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isFloat()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isSize()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else {
-                continue;
-            }
-            np::float_ resultAbs;
-            np::ndarray::internal::abs(result, resultAbs);
-            auto a = resultAbs;
-            np::float_ resultMul;
-            np::ndarray::internal::multiply(a, a, resultMul);
-            x.push_back(resultMul);
-        }
-        np::float_ resultSqrt;
-        np::ndarray::internal::sqrt(x.nanmean(), resultSqrt);
-        return resultSqrt;
-    }
-
-    static np::float_ nanstd_(const np::Array<internal::Value> &array) {
-        np::ndarray::array_dynamic::NDArrayDynamic<np::float_> x;
-        np::float_ m = nanmean_(array);
-        for (np::Size i = 0; i < array.size(); ++i) {
-            const auto &element = array.get(i);
-            bool isNaNResult{};
-            np::ndarray::internal::isNaN(element, isNaNResult);
-            if (isNaNResult)
-                continue;
-            np::float_ result;
-            if (element.isInt()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isIntC()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isFloat()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isSize()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else {
-                continue;
-            }
-            np::float_ resultAbs;
-            np::ndarray::internal::abs(result, resultAbs);
-            auto a = resultAbs;
-            np::float_ resultMul;
-            np::ndarray::internal::multiply(a, a, resultMul);
-            x.push_back(resultMul);
-        }
-        np::float_ resultSqrt;
-        np::ndarray::internal::sqrt(x.nanmean(), resultSqrt);
-        return resultSqrt;
-    }
-
-    static np::float_ var_(const np::Array<internal::Value> &array) {
-        np::ndarray::array_dynamic::NDArrayDynamic<np::float_> x;
-        np::float_ m = mean_(array);
-        for (np::Size i = 0; i < array.size(); ++i) {
-            const auto &element = array.get(i);
-            np::float_ result;
-            if (element.isInt()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isIntC()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isFloat()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isSize()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else {
-                continue;
-            }
-            np::float_ resultAbs;
-            np::ndarray::internal::abs(result, resultAbs);
-            auto a = resultAbs;
-            np::float_ resultMul;
-            np::ndarray::internal::multiply(a, a, resultMul);
-            x.push_back(resultMul);
-        }
-        return x.mean();
-    }
-
-    static np::float_ nanvar_(const np::Array<internal::Value> &array) {
-        np::ndarray::array_dynamic::NDArrayDynamic<np::float_> x;
-        np::float_ m = nanmean_(array);
-        for (np::Size i = 0; i < array.size(); ++i) {
-            const auto &element = array.get(i);
-            bool isNaNResult{};
-            np::ndarray::internal::isNaN(element, isNaNResult);
-            if (isNaNResult)
-                continue;
-            np::float_ result;
-            if (element.isInt()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isIntC()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isFloat()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else if (element.isSize()) {
-                np::ndarray::internal::subtract<np::float_>(static_cast<np::float_>(element), m, result);
-            } else {
-                continue;
+    template<typename DType>
+    static internal::HyperLogLog hyperloglog(const np::Array<DType> &array, np::Size precision) {
+        static const constexpr np::Size kMinRowsPerThread = 1 << 16;
+        std::vector<internal::HyperLogLog> partial(internal::chunkCount(array.size(), kMinRowsPerThread), internal::HyperLogLog{precision});
+        internal::parallelFor(array.size(), kMinRowsPerThread, [&](np::Size chunk, np::Size begin, np::Size end) {
+            for (np::Size i = begin; i < end; ++i) {
+                const DType &value = array.get(i);
+                if (!isNaNValue(value)) {
+                    partial[chunk].add(internal::hashKey<DType>(value));
+                }
             }
-            np::float_ resultAbs;
-            np::ndarray::internal::abs(result, resultAbs);
-            auto a = resultAbs;
-            np::float_ resultMul;
-            np::ndarray::internal::multiply(a, a, resultMul);
-            x.push_back(resultMul);
+        });
+        internal::HyperLogLog result{precision};
+        for (const auto &sketch: partial) {
+            result.merge(sketch);
         }
-        return x.nanmean();
+        return result;
     }
 
-    np::float_ Series::std_(bool skipna) const {
-        if (m_data.isIntCArray()) {
-            const auto *array = static_cast<const np::Array<np::intc> *>(m_data);
-            if (skipna)
-                return array->nanstd();
-            else
-                return array->std_();
+    internal::HyperLogLog Series::hyperloglog(np::Size precision) const {
+        if (m_data.isBoolArray()) {
+            return pd::hyperloglog(*static_cast<const np::Array<np::bool_> *>(m_data), precision);
+        } else if (m_data.isIntCArray()) {
+            return pd::hyperloglog(*static_cast<const np::Array<np::intc> *>(m_data), precision);
         } else if (m_data.isIntArray()) {
-            const auto *array = static_cast<const np::Array<np::int_> *>(m_data);
-            if (skipna)
-                return array->nanstd();
-            else
-                return array->std_();
+            return pd::hyperloglog(*static_cast<const np::Array<np::int_> *>(m_data), precision);
         } else if (m_data.isSizeArray()) {
-            const auto *array = static_cast<const np::Array<np::Size> *>(m_data);
-            if (skipna)
-                return array->nanstd();
-            else
-                return array->std_();
+            return pd::hyperloglog(*static_cast<const np::Array<np::Size> *>(m_data), precision);
         } else if (m_data.isFloatArray()) {
-            const auto *array = static_cast<const np::Array<np::float_> *>(m_data);
-            if (skipna)
-                return array->nanstd();
-            else
-                return array->std_();
+            return pd::hyperloglog(*static_cast<const np::Array<np::float_> *>(m_data), precision);
+        } else if (m_data.isStringArray()) {
+            return pd::hyperloglog(*static_cast<const np::Array<np::string_> *>(m_data), precision);
+        } else if (m_data.isUnicodeArray()) {
+            return pd::hyperloglog(*static_cast<const np::Array<np::unicode_> *>(m_data), precision);
         } else if (m_data.isValueArray()) {
-            const auto *array = static_cast<const np::Array<internal::Value> *>(m_data);
-            if (skipna)
-                return nanstd_(*array);
-            else
-                return std__(*array);
-        } else {
-            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot calculate mean of a non-number array");
+            return pd::hyperloglog(*static_cast<const np::Array<internal::Value> *>(m_data), precision);
         }
+        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
     }
 
-    np::float_ Series::var(bool skipna) const {
-        if (m_data.isIntCArray()) {
-            const auto *array = static_cast<const np::Array<np::intc> *>(m_data);
-            if (skipna)
-                return array->nanvar();
-            else
-                return array->var();
+    np::Size Series::approx_nunique(np::Size precision) const {
+        return static_cast<np::Size>(std::llround(hyperloglog(precision).estimate()));
+    }
+
+    template<typename DType>
+    static internal::SpaceSaving<internal::Value> spaceSaving(const np::Array<DType> &array, np::Size capacity) {
+        static const constexpr np::Size kMinRowsPerThread = 1 << 16;
+        std::vector<internal::SpaceSaving<DType>> partial(internal::chunkCount(array.size(), kMinRowsPerThread), internal::SpaceSaving<DType>{capacity});
+        internal::parallelFor(array.size(), kMinRowsPerThread, [&](np::Size chunk, np::Size begin, np::Size end) {
+            for (np::Size i = begin; i < end; ++i) {
+                partial[chunk].add(array.get(i));
+            }
+        });
+        internal::SpaceSaving<DType> merged{capacity};
+        for (const auto &sketch: partial) {
+            merged.merge(sketch);
+        }
+        return merged.template convertKeys<internal::Value>([](const DType &key) { return internal::Value{key}; });
+    }
+
+    internal::SpaceSaving<internal::Value> Series::space_saving(np::Size capacity) const {
+        if (m_data.isBoolArray()) {
+            return spaceSaving(*static_cast<const np::Array<np::bool_> *>(m_data), capacity);
+        } else if (m_data.isIntCArray()) {
+            return spaceSaving(*static_cast<const np::Array<np::intc> *>(m_data), capacity);
         } else if (m_data.isIntArray()) {
-            const auto *array = static_cast<const np::Array<np::int_> *>(m_data);
-            if (skipna)
-                return array->nanvar();
-            else
-                return array->var();
+            return spaceSaving(*static_cast<const np::Array<np::int_> *>(m_data), capacity);
         } else if (m_data.isSizeArray()) {
-            const auto *array = static_cast<const np::Array<np::Size> *>(m_data);
-            if (skipna)
-                return array->nanvar();
-            else
-                return array->var();
+            return spaceSaving(*static_cast<const np::Array<np::Size> *>(m_data), capacity);
         } else if (m_data.isFloatArray()) {
-            const auto *array = static_cast<const np::Array<np::float_> *>(m_data);
-            if (skipna)
-                return array->nanvar();
-            else
-                return array->var();
+            return spaceSaving(*static_cast<const np::Array<np::float_> *>(m_data), capacity);
+        } else if (m_data.isStringArray()) {
+            return spaceSaving(*static_cast<const np::Array<np::string_> *>(m_data), capacity);
+        } else if (m_data.isUnicodeArray()) {
+            return spaceSaving(*static_cast<const np::Array<np::unicode_> *>(m_data), capacity);
         } else if (m_data.isValueArray()) {
-            const auto *array = static_cast<const np::Array<internal::Value> *>(m_data);
-            if (skipna)
-                return nanvar_(*array);
-            else
-                return var_(*array);
-        } else {
-            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot calculate mean of a non-number array");
+            return spaceSaving(*static_cast<const np::Array<internal::Value> *>(m_data), capacity);
         }
+        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
+    }
+
+    Series Series::approx_top_k(np::Size k, np::Size capacity) const {
+        auto counters = space_saving(capacity == 0 ? std::max<np::Size>(10 * k, 1) : capacity).top(k);
+        np::Array<np::int_> counts{np::Shape{static_cast<np::Size>(counters.size())}};
+        std::vector<internal::Value> index;
+        for (np::Size i = 0; i < counters.size(); ++i) {
+            counts.set(i, static_cast<np::int_>(counters[i].count));
+            index.push_back(counters[i].key);
+        }
+        return Series{std::move(counts), index, m_name};
     }
 
     Series Series::replace(internal::Value to_replace, internal::Value value) const {
@@ -686,7 +720,7 @@ namespace pd {
                         arrayDst.set(row, arraySrc->get(row));
                     }
                 }
-                return Series{arrayDst, m_name};
+                return Series{std::move(arrayDst), m_name};
             } else if (value.isFloat()) {
                 const auto *arraySrc = static_cast<const np::Array<np::int_> *>(m_data);
                 np::Array<np::float_> arrayDst{m_shape};
@@ -697,7 +731,7 @@ namespace pd {
                         arrayDst.set(row, static_cast<np::float_>(arraySrc->get(row)));
                     }
                 }
-                return Series{arrayDst, m_name};
+                return Series{std::move(arrayDst), m_name};
             } else if (value.isString() || value.isUnicode()) {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot replace value to string in int array");
             } else {
@@ -735,7 +769,7 @@ namespace pd {
                         }
                     }
                 }
-                return Series{arrayDst, m_name};
+                return Series{std::move(arrayDst), m_name};
             } else if (value.isFloat()) {
                 const auto *arraySrc = static_cast<const np::Array<np::float_> *>(m_data);
                 np::Array<np::float_> arrayDst{m_shape};
@@ -763,7 +797,7 @@ namespace pd {
                         }
                     }
                 }
-                return Series{arrayDst, m_name};
+                return Series{std::move(arrayDst), m_name};
             } else if (value.isString() || value.isUnicode()) {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot replace value to string in float array");
             } else {
@@ -785,7 +819,7 @@ namespace pd {
                         arrayDst.set(row, arraySrc->get(row));
                     }
                 }
-                return Series{arrayDst, m_name};
+                return Series{std::move(arrayDst), m_name};
             } else if (value.isUnicode()) {
                 const auto *valueUnicode = static_cast<const np::unicode_ *>(value);
                 np::Array<np::unicode_> arrayDst{m_shape};
@@ -810,7 +844,7 @@ namespace pd {
                         arrayDst.set(row, arrayWStr);
                     }
                 }
-                return Series{arrayDst, m_name};
+                return Series{std::move(arrayDst), m_name};
             } else if (value.isIntC() || value.isInt() || value.isFloat()) {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot replace value to number in string array");
             } else {
@@ -843,7 +877,7 @@ namespace pd {
                         arrayDst.set(row, arrayStr);
                     }
                 }
-                return Series{arrayDst, m_name};
+                return Series{std::move(arrayDst), m_name};
             } else if (value.isUnicode()) {
                 const auto *valueUnicode = static_cast<const np::unicode_ *>(value);
                 const auto *arraySrc = static_cast<const np::Array<np::unicode_> *>(m_data);
@@ -855,7 +889,7 @@ namespace pd {
                         arrayDst.set(row, arraySrc->get(row));
                     }
                 }
-                return Series{arrayDst, m_name};
+                return Series{std::move(arrayDst), m_name};
             } else if (value.isIntC() || value.isInt() || value.isFloat()) {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot replace value to number in unicode array");
             } else {
@@ -866,38 +900,375 @@ namespace pd {
         }
     }
 
-    internal::Value Series::dot(const Series &another) const {
-        if (shape().size() != 1 || another.shape().size() != 1 || shape() != another.shape()) {
-            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Shapes are different or arguments are not 1D arrays");
+    enum class ValueKind {
+        kInteger,
+        kFloat,
+        kString,
+        kUnicode,
+        kOther
+    };
+
+    static ValueKind kindOf(const internal::Value &value) {
+        if (value.isBool() || value.isInt() || value.isIntC() || value.isSize()) {
+            return ValueKind::kInteger;
+        } else if (value.isFloat()) {
+            return ValueKind::kFloat;
+        } else if (value.isString()) {
+            return ValueKind::kString;
+        } else if (value.isUnicode()) {
+            return ValueKind::kUnicode;
+        }
+        return ValueKind::kOther;
+    }
+
+    static ValueKind kindOf(const internal::Array &data) {
+        if (data.isBoolArray() || data.isIntArray() || data.isIntCArray() || data.isSizeArray()) {
+            return ValueKind::kInteger;
+        } else if (data.isFloatArray()) {
+            return ValueKind::kFloat;
+        } else if (data.isStringArray()) {
+            return ValueKind::kString;
+        } else if (data.isUnicodeArray()) {
+            return ValueKind::kUnicode;
+        }
+        return ValueKind::kOther;
+    }
+
+    static ValueKind commonKind(ValueKind kind1, ValueKind kind2) {
+        if (kind1 == kind2) {
+            return kind1;
+        }
+        if ((kind1 == ValueKind::kInteger && kind2 == ValueKind::kFloat) || (kind1 == ValueKind::kFloat && kind2 == ValueKind::kInteger)) {
+            return ValueKind::kFloat;
+        }
+        return ValueKind::kOther;
+    }
+
+    template<typename DType>
+    static DType convertValue(const internal::Value &value) {
+        if constexpr (std::is_same_v<DType, internal::Value>) {
+            return value;
+        } else if constexpr (std::is_arithmetic_v<DType>) {
+            if (value.isBool()) {
+                return static_cast<DType>(static_cast<np::bool_>(value));
+            } else if (value.isInt()) {
+                return static_cast<DType>(static_cast<np::int_>(value));
+            } else if (value.isIntC()) {
+                return static_cast<DType>(static_cast<np::intc>(value));
+            } else if (value.isSize()) {
+                return static_cast<DType>(static_cast<np::Size>(value));
+            }
+            return static_cast<DType>(static_cast<np::float_>(value));
+        } else {
+            return *static_cast<const DType *>(value);
+        }
+    }
+
+    // Whether the integer value converts to DType without changing
+    template<typename DType>
+    static bool fitsIn(const internal::Value &value) {
+        if constexpr (std::is_same_v<DType, np::bool_>) {
+            return value.isBool();
+        } else {
+            if (value.isBool()) {
+                return true;
+            } else if (value.isSize()) {
+                return std::in_range<DType>(static_cast<np::Size>(value));
+            } else if (value.isIntC()) {
+                return std::in_range<DType>(static_cast<np::intc>(value));
+            }
+            return std::in_range<DType>(static_cast<np::int_>(value));
+        }
+    }
+
+    template<typename DType>
+    static bool allFitIn(const std::vector<internal::Value> &values) {
+        return std::all_of(values.begin(), values.end(), fitsIn<DType>);
+    }
+
+    // Whether every element of the integer array converts to int64 without changing
+    template<typename DType>
+    static bool fitsInInt(const np::Array<DType> &data) {
+        if constexpr (std::is_same_v<DType, np::Size>) {
+            for (np::Size row = 0; row < data.size(); ++row) {
+                if (!std::in_range<np::int_>(data.get(row))) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // result[row] = values[matches[row]] for matched rows, convert(data[row]) for the others
+    template<typename Result, typename DType, typename Convert>
+    static np::Array<Result> substitute(const np::Array<DType> &data, const std::vector<np::Size> &matches,
+                                        const std::vector<internal::Value> &values, Convert &&convert) {
+        // Converted once, the row loop does no dispatch on the value type
+        std::vector<Result> typedValues;
+        typedValues.reserve(values.size());
+        for (const auto &value: values) {
+            typedValues.push_back(convertValue<Result>(value));
         }
-        internal::Value result{0};
-        for (np::Size i = 0; i < size(); ++i) {
-            internal::Value multipleResult{};
-            if (m_data.isIntCArray()) {
-                if (!another.m_data.isIntCArray()) {
-                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid value type");
+        np::Array<Result> result{np::Shape{data.size()}};
+        for (np::Size row = 0; row < data.size(); ++row) {
+            result.set(row, matches[row] == internal::kNoMatch ? convert(data.get(row)) : typedValues[matches[row]]);
+        }
+        return result;
+    }
+
+    template<typename DType>
+    static internal::Array substitute(const np::Array<DType> &data, const std::vector<np::Size> &matches,
+                                      const std::vector<internal::Value> &values, ValueKind kind, bool keepUnmatched) {
+        auto nan = std::numeric_limits<np::float_>::quiet_NaN();
+        // Integers keep the dtype when every value fits, then widen to int64 and at last to float64
+        if (kind == ValueKind::kInteger && keepUnmatched) {
+            if constexpr (std::is_integral_v<DType>) {
+                if (allFitIn<DType>(values)) {
+                    return internal::Array{substitute<DType>(data, matches, values, [](DType value) { return value; })};
                 }
-                result += static_cast<np::intc>(at(i)) * static_cast<np::intc>(another.at(i));
-            } else if (m_data.isIntArray()) {
-                if (!another.m_data.isIntArray()) {
-                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid value type");
+                if (allFitIn<np::int_>(values) && fitsInInt(data)) {
+                    return internal::Array{substitute<np::int_>(data, matches, values, [](DType value) { return static_cast<np::int_>(value); })};
                 }
-                result += static_cast<np::int_>(at(i)) * static_cast<np::int_>(another.at(i));
-            } else if (m_data.isSizeArray()) {
-                if (!another.m_data.isSizeArray()) {
-                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid value type");
+            }
+        }
+        if (kind == ValueKind::kInteger && !keepUnmatched && allFitIn<np::int_>(values)) {
+            return internal::Array{substitute<np::int_>(data, matches, values, [](const DType &) { return np::int_{0}; })};
+        }
+        if (kind == ValueKind::kInteger || kind == ValueKind::kFloat) {
+            return internal::Array{substitute<np::float_>(data, matches, values, [keepUnmatched, nan](const DType &value) {
+                if constexpr (std::is_arithmetic_v<DType>) {
+                    return keepUnmatched ? static_cast<np::float_>(value) : nan;
+                } else {
+                    return nan;
+                }
+            })};
+        }
+        if (kind == ValueKind::kString) {
+            return internal::Array{substitute<np::string_>(data, matches, values, [](const DType &value) {
+                if constexpr (std::is_same_v<DType, np::string_>) {
+                    return value;
+                } else {
+                    return np::string_{};
                 }
-                result += static_cast<np::Size>(at(i)) * static_cast<np::Size>(another.at(i));
-            } else if (m_data.isFloatArray()) {
-                if (!another.m_data.isFloatArray()) {
-                    PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid value type");
+            })};
+        }
+        if (kind == ValueKind::kUnicode) {
+            return internal::Array{substitute<np::unicode_>(data, matches, values, [](const DType &value) {
+                if constexpr (std::is_same_v<DType, np::unicode_>) {
+                    return value;
+                } else {
+                    return np::unicode_{};
                 }
-                result += static_cast<np::float_>(at(i)) * static_cast<np::float_>(another.at(i));
-            } else {
-                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid value type");
+            })};
+        }
+        return internal::Array{substitute<internal::Value>(data, matches, values, [keepUnmatched, nan](const DType &value) {
+            return keepUnmatched ? internal::Value{value} : internal::Value{nan};
+        })};
+    }
+
+    static internal::Array substitute(const internal::Array &data, const std::vector<np::Size> &matches,
+                                      const std::vector<internal::Value> &values, ValueKind kind, bool keepUnmatched) {
+        if (data.isBoolArray()) {
+            return substitute(*static_cast<const np::Array<np::bool_> *>(data), matches, values, kind, keepUnmatched);
+        } else if (data.isIntCArray()) {
+            return substitute(*static_cast<const np::Array<np::intc> *>(data), matches, values, kind, keepUnmatched);
+        } else if (data.isIntArray()) {
+            return substitute(*static_cast<const np::Array<np::int_> *>(data), matches, values, kind, keepUnmatched);
+        } else if (data.isSizeArray()) {
+            return substitute(*static_cast<const np::Array<np::Size> *>(data), matches, values, kind, keepUnmatched);
+        } else if (data.isFloatArray()) {
+            return substitute(*static_cast<const np::Array<np::float_> *>(data), matches, values, kind, keepUnmatched);
+        } else if (data.isStringArray()) {
+            return substitute(*static_cast<const np::Array<np::string_> *>(data), matches, values, kind, keepUnmatched);
+        } else if (data.isUnicodeArray()) {
+            return substitute(*static_cast<const np::Array<np::unicode_> *>(data), matches, values, kind, keepUnmatched);
+        } else if (data.isValueArray()) {
+            return substitute(*static_cast<const np::Array<internal::Value> *>(data), matches, values, kind, keepUnmatched);
+        }
+        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Unknown type");
+    }
+
+    static int typeRank(const internal::Value &value) {
+        if (value.isBool()) {
+            return 0;
+        } else if (value.isIntC()) {
+            return 1;
+        } else if (value.isInt()) {
+            return 2;
+        } else if (value.isSize()) {
+            return 3;
+        } else if (value.isFloat()) {
+            return 4;
+        } else if (value.isString()) {
+            return 5;
+        } else if (value.isUnicode()) {
+            return 6;
+        }
+        return 7;
+    }
+
+    static long double numberOf(const internal::Value &value) {
+        if (value.isBool()) {
+            return static_cast<np::bool_>(value) ? 1.0L : 0.0L;
+        } else if (value.isIntC()) {
+            return static_cast<np::intc>(value);
+        } else if (value.isInt()) {
+            return static_cast<np::int_>(value);
+        } else if (value.isSize()) {
+            return static_cast<np::Size>(value);
+        }
+        return static_cast<np::float_>(value);
+    }
+
+    // Mapping items in a fixed order. Lookup takes the first of keys matching alike (1 and 1.0),
+    // so equal numbers are ordered by type and the narrowest one wins whatever the hash map order.
+    static std::vector<std::pair<internal::Value, internal::Value>> orderedItems(const std::unordered_map<internal::Value, internal::Value> &mapping) {
+        std::vector<std::pair<internal::Value, internal::Value>> items{mapping.begin(), mapping.end()};
+        std::sort(items.begin(), items.end(), [](const auto &item1, const auto &item2) {
+            const auto &key1 = item1.first;
+            const auto &key2 = item2.first;
+            auto numeric1 = kindOf(key1) == ValueKind::kInteger || kindOf(key1) == ValueKind::kFloat;
+            auto numeric2 = kindOf(key2) == ValueKind::kInteger || kindOf(key2) == ValueKind::kFloat;
+            if (numeric1 && numeric2) {
+                auto number1 = numberOf(key1);
+                auto number2 = numberOf(key2);
+                // NaN goes last
+                if (std::isnan(number1) != std::isnan(number2)) {
+                    return std::isnan(number2);
+                }
+                if (!std::isnan(number1) && number1 != number2) {
+                    return number1 < number2;
+                }
+                return typeRank(key1) < typeRank(key2);
+            }
+            if (typeRank(key1) != typeRank(key2)) {
+                return typeRank(key1) < typeRank(key2);
             }
+            if (key1.isString()) {
+                return *static_cast<const np::string_ *>(key1) < *static_cast<const np::string_ *>(key2);
+            } else if (key1.isUnicode()) {
+                return *static_cast<const np::unicode_ *>(key1) < *static_cast<const np::unicode_ *>(key2);
+            }
+            return false;
+        });
+        return items;
+    }
+
+    Series Series::replace(const std::unordered_map<internal::Value, internal::Value> &to_replace) const {
+        std::vector<internal::Value> keys;
+        std::vector<internal::Value> values;
+        auto kind = kindOf(m_data);
+        for (const auto &[key, value]: orderedItems(to_replace)) {
+            keys.push_back(key);
+            values.push_back(value);
+            kind = commonKind(kind, kindOf(value));
         }
-        return result;
+        auto matches = internal::lookup(m_data, keys);
+        return Series{substitute(m_data, matches, values, kind, true), m_index.labels(), m_name};
+    }
+
+    Series Series::map(const std::unordered_map<internal::Value, internal::Value> &mapping) const {
+        std::vector<internal::Value> keys;
+        std::vector<internal::Value> values;
+        for (const auto &[key, value]: orderedItems(mapping)) {
+            keys.push_back(key);
+            values.push_back(value);
+        }
+        auto matches = internal::lookup(m_data, keys);
+        auto unmatched = std::find(matches.begin(), matches.end(), internal::kNoMatch) != matches.end();
+
+        auto kind = values.empty() ? ValueKind::kFloat : kindOf(values.front());
+        for (const auto &value: values) {
+            kind = commonKind(kind, kindOf(value));
+        }
+        // NaN for rows without a key turns integers into floats and strings into values
+        if (unmatched && kind == ValueKind::kInteger) {
+            kind = ValueKind::kFloat;
+        } else if (unmatched && (kind == ValueKind::kString || kind == ValueKind::kUnicode)) {
+            kind = ValueKind::kOther;
+        }
+        return Series{substitute(m_data, matches, values, kind, false), m_index.labels(), m_name};
+    }
+
+    std::vector<bool> Series::isin(const std::vector<internal::Value> &values) const {
+        return internal::isin(m_data, values);
+    }
+
+    template<typename DType>
+    static DType integerDot(const np::Array<DType> &x, const np::Array<DType> &y) {
+        DType sums[4]{};
+        np::Size i = 0;
+        for (; i + 4 <= x.size(); i += 4) {
+            sums[0] += x.get(i) * y.get(i);
+            sums[1] += x.get(i + 1) * y.get(i + 1);
+            sums[2] += x.get(i + 2) * y.get(i + 2);
+            sums[3] += x.get(i + 3) * y.get(i + 3);
+        }
+        for (; i < x.size(); ++i) {
+            sums[0] += x.get(i) * y.get(i);
+        }
+        return sums[0] + sums[1] + sums[2] + sums[3];
+    }
+
+    // Smallest number of elements worth a separate thread
+    static const constexpr np::Size kMinDotPerThread = 1 << 16;
+
+    static np::float_ floatDot(const internal::Array &x, const internal::Array &y, Summation summation) {
+        auto size = x.size();
+        auto chunks = internal::chunkCount(size, kMinDotPerThread);
+        std::vector<internal::CompensatedSum> compensated(chunks);
+        std::vector<internal::PairwiseSum> pairwise(chunks);
+        std::vector<np::float_> fast(chunks, 0.0);
+        internal::parallelFor(size, kMinDotPerThread, [&](np::Size chunk, np::Size begin, np::Size end) {
+            np::float_ blockX[internal::kBlockSize];
+            np::float_ blockY[internal::kBlockSize];
+            for (auto row = begin; row < end; row += internal::kBlockSize) {
+                auto count = std::min(internal::kBlockSize, end - row);
+                internal::loadBlock(x, row, count, blockX);
+                internal::loadBlock(y, row, count, blockY);
+                if (summation == Summation::kFast) {
+                    fast[chunk] += internal::dotBlock(blockX, blockY, count);
+                } else if (summation == Summation::kPairwise) {
+                    pairwise[chunk].add(internal::pairwiseDot(blockX, blockY, count));
+                } else {
+                    for (np::Size i = 0; i < count; ++i) {
+                        compensated[chunk].add(blockX[i] * blockY[i]);
+                    }
+                }
+            }
+        });
+        // Chunks are combined in order, so the result does not depend on thread timing
+        if (summation == Summation::kFast) {
+            return std::accumulate(fast.begin(), fast.end(), 0.0);
+        } else if (summation == Summation::kPairwise) {
+            internal::PairwiseSum total;
+            for (const auto &sum: pairwise) {
+                total.add(sum.result());
+            }
+            return total.result();
+        }
+        internal::CompensatedSum total;
+        for (const auto &sum: compensated) {
+            total.merge(sum);
+        }
+        return total.result();
+    }
+
+    internal::Value Series::dot(const Series &another, Summation summation) const {
+        if (shape().size() != 1 || another.shape().size() != 1 || shape() != another.shape()) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Shapes are different or arguments are not 1D arrays");
+        }
+        if (m_data.isIntCArray() && another.m_data.isIntCArray()) {
+            return internal::Value{integerDot(*static_cast<const np::Array<np::intc> *>(m_data), *static_cast<const np::Array<np::intc> *>(another.m_data))};
+        } else if (m_data.isIntArray() && another.m_data.isIntArray()) {
+            return internal::Value{integerDot(*static_cast<const np::Array<np::int_> *>(m_data), *static_cast<const np::Array<np::int_> *>(another.m_data))};
+        } else if (m_data.isSizeArray() && another.m_data.isSizeArray()) {
+            return internal::Value{integerDot(*static_cast<const np::Array<np::Size> *>(m_data), *static_cast<const np::Array<np::Size> *>(another.m_data))};
+        }
+        if (!internal::isNumeric(m_data) || !internal::isNumeric(another.m_data)) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid value type");
+        }
+        return internal::Value{floatDot(m_data, another.m_data, summation)};
     }
 
     static void printMemoryUsage(std::size_t bytes) {
@@ -0,0 +1,65 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pd/Exception.hpp>
+#include <pd/core/window/Expanding/Expanding.hpp>
+#include <pd/core/window/Window.hpp>
+
+namespace pd {
+    template<typename Object>
+    Expanding<Object>::Expanding(const Object &object, np::Size minPeriods)
+        : m_object{object}, m_minPeriods{minPeriods} {
+    }
+
+    template<typename Object>
+    Object Expanding<Object>::sum() const {
+        return internal::aggregateWindow(m_object, 0, m_minPeriods, internal::WindowFunction::kSum, 0);
+    }
+
+    template<typename Object>
+    Object Expanding<Object>::mean() const {
+        return internal::aggregateWindow(m_object, 0, m_minPeriods, internal::WindowFunction::kMean, 0);
+    }
+
+    template<typename Object>
+    Object Expanding<Object>::var(np::Size ddof) const {
+        return internal::aggregateWindow(m_object, 0, m_minPeriods, internal::WindowFunction::kVar, ddof);
+    }
+
+    template<typename Object>
+    Object Expanding<Object>::std_(np::Size ddof) const {
+        return internal::aggregateWindow(m_object, 0, m_minPeriods, internal::WindowFunction::kStd, ddof);
+    }
+
+    template<typename Object>
+    Object Expanding<Object>::min() const {
+        return internal::aggregateWindow(m_object, 0, m_minPeriods, internal::WindowFunction::kMin, 0);
+    }
+
+    template<typename Object>
+    Object Expanding<Object>::max() const {
+        return internal::aggregateWindow(m_object, 0, m_minPeriods, internal::WindowFunction::kMax, 0);
+    }
+
+    template class Expanding<Series>;
+    template class Expanding<DataFrame>;
+}// namespace pd
@@ -0,0 +1,192 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include <pd/Exception.hpp>
+#include <pd/core/internal/Parallel.hpp>
+#include <pd/core/internal/Reduction.hpp>
+#include <pd/core/window/Window.hpp>
+
+namespace pd {
+    namespace internal {
+        // Running sum, mean and M2 of the values inside a window, supporting removal of the oldest value
+        class RunningMoments {
+        public:
+            void add(np::float_ value) {
+                ++m_count;
+                addToSum(value);
+                auto delta = value - m_mean;
+                m_mean += delta / static_cast<np::float_>(m_count);
+                m_m2 += delta * (value - m_mean);
+            }
+
+            void remove(np::float_ value) {
+                --m_count;
+                addToSum(-value);
+                if (m_count == 0) {
+                    m_mean = 0.0;
+                    m_m2 = 0.0;
+                    m_sum = 0.0;
+                    m_compensation = 0.0;
+                    return;
+                }
+                auto delta = value - m_mean;
+                m_mean -= delta / static_cast<np::float_>(m_count);
+                m_m2 = std::max(0.0, m_m2 - delta * (value - m_mean));
+            }
+
+            [[nodiscard]] np::Size count() const {
+                return m_count;
+            }
+
+            [[nodiscard]] np::float_ sum() const {
+                return m_sum + m_compensation;
+            }
+
+            [[nodiscard]] np::float_ variance(np::Size ddof) const {
+                return m_count <= ddof ? std::numeric_limits<np::float_>::quiet_NaN() : m_m2 / static_cast<np::float_>(m_count - ddof);
+            }
+
+        private:
+            // Neumaier summation: sliding sums do not accumulate rounding errors
+            void addToSum(np::float_ value) {
+                auto sum = m_sum + value;
+                if (std::abs(m_sum) >= std::abs(value)) {
+                    m_compensation += (m_sum - sum) + value;
+                } else {
+                    m_compensation += (value - sum) + m_sum;
+                }
+                m_sum = sum;
+            }
+
+            np::Size m_count{0};
+            np::float_ m_mean{0.0};
+            np::float_ m_m2{0.0};
+            np::float_ m_sum{0.0};
+            np::float_ m_compensation{0.0};
+        };
+
+        static void aggregateMoments(const std::vector<np::float_> &values, np::Size window, np::Size minPeriods,
+                                     WindowFunction function, np::Size ddof, np::Array<np::float_> &result) {
+            RunningMoments moments;
+            for (np::Size i = 0; i < values.size(); ++i) {
+                if (!std::isnan(values[i])) {
+                    moments.add(values[i]);
+                }
+                if (window != 0 && i >= window && !std::isnan(values[i - window])) {
+                    moments.remove(values[i - window]);
+                }
+
+                auto value = std::numeric_limits<np::float_>::quiet_NaN();
+                if (moments.count() >= minPeriods) {
+                    if (function == WindowFunction::kSum) {
+                        value = moments.sum();
+                    } else if (function == WindowFunction::kMean) {
+                        if (moments.count() > 0) {
+                            value = moments.sum() / static_cast<np::float_>(moments.count());
+                        }
+                    } else if (function == WindowFunction::kVar) {
+                        value = moments.variance(ddof);
+                    } else {
+                        value = std::sqrt(moments.variance(ddof));
+                    }
+                }
+                result.set(i, value);
+            }
+        }
+
+        static void aggregateExtremum(const std::vector<np::float_> &values, np::Size window, np::Size minPeriods,
+                                      bool minimum, np::Array<np::float_> &result) {
+            // Positions of the values that can still become the window extremum, their values are monotonic
+            std::deque<np::Size> candidates;
+            np::Size count = 0;
+            for (np::Size i = 0; i < values.size(); ++i) {
+                auto value = values[i];
+                if (!std::isnan(value)) {
+                    ++count;
+                    while (!candidates.empty() && (minimum ? values[candidates.back()] >= value : values[candidates.back()] <= value)) {
+                        candidates.pop_back();
+                    }
+                    candidates.push_back(i);
+                }
+                if (window != 0 && i >= window) {
+                    if (!std::isnan(values[i - window])) {
+                        --count;
+                    }
+                    while (!candidates.empty() && candidates.front() + window <= i) {
+                        candidates.pop_front();
+                    }
+                }
+                result.set(i, count >= minPeriods && !candidates.empty() ? values[candidates.front()] : std::numeric_limits<np::float_>::quiet_NaN());
+            }
+        }
+
+        np::Array<np::float_> aggregateWindow(const Array &data, np::Size window, np::Size minPeriods,
+                                              WindowFunction function, np::Size ddof) {
+            if (!isNumeric(data)) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Window functions require a numeric array");
+            }
+            auto size = data.size();
+            std::vector<np::float_> values(size);
+            for (np::Size row = 0; row < size; row += kBlockSize) {
+                loadBlock(data, row, std::min(kBlockSize, size - row), values.data() + row);
+            }
+
+            np::Array<np::float_> result{np::Shape{size}};
+            if (function == WindowFunction::kMin || function == WindowFunction::kMax) {
+                aggregateExtremum(values, window, minPeriods, function == WindowFunction::kMin, result);
+            } else {
+                aggregateMoments(values, window, minPeriods, function, ddof, result);
+            }
+            return result;
+        }
+
+        Series aggregateWindow(const Series &series, np::Size window, np::Size minPeriods,
+                               WindowFunction function, np::Size ddof) {
+            return Series{aggregateWindow(series.values(), window, minPeriods, function, ddof), series.index().labels(), series.name()};
+        }
+
+        DataFrame aggregateWindow(const DataFrame &dataFrame, np::Size window, np::Size minPeriods,
+                                  WindowFunction function, np::Size ddof) {
+            auto columns = dataFrame.columns().getIndex();
+            // The row labels belong to the frame, not to its columns
+            auto index = dataFrame.index();
+            const auto &labels = index.labels();
+            std::vector<Series> results(columns.size());
+            parallelFor(static_cast<np::Size>(columns.size()), 1, [&](np::Size, np::Size begin, np::Size end) {
+                for (np::Size column = begin; column < end; ++column) {
+                    const auto &series = dataFrame[columns[column]];
+                    results[column] = Series{aggregateWindow(series.values(), window, minPeriods, function, ddof), labels, series.name()};
+                }
+            });
+            DataFrame result;
+            for (auto &series: results) {
+                result.append(series);
+            }
+            return result;
+        }
+    }// namespace internal
+}// namespace pd
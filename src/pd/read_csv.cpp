@@ -21,245 +21,442 @@ SOFTWARE.
 */
 
 #include <atomic>
+#include <cctype>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include <pd/Exception.hpp>
+#include <pd/core/internal/Parallel.hpp>
+#include <pd/core/internal/SpscRingBuffer.hpp>
+#include <pd/core/internal/httpreader/HttpCache.hpp>
 #include <pd/core/internal/httpreader/HttpHandler.hpp>
 #include <pd/core/internal/httpreader/HttpsHandler.hpp>
 #include <pd/core/internal/httpreader/Initializer.hpp>
 #include <pd/core/internal/httpreader/Poll.hpp>
+#include <pd/core/internal/httpreader/RangeDownloader.hpp>
 #include <pd/core/internal/httpreader/SslInitializer.hpp>
 #include <pd/core/internal/httpreader/UriParser.hpp>
 #include <pd/read_csv.hpp>
 
 namespace pd {
+    // The input is parsed as it arrives: complete lines are tokenized straight from the received
+    // data and only the incomplete last line is kept, so memory is bounded by the parsed values.
     struct ReadCsvContext {
         explicit ReadCsvContext(const ReadCsvSettings &settings)
-            : m_settings{settings} {
+            : m_settings{settings}, m_separator{settings.separator == Separator::kComma ? ',' : settings.separator == Separator::kTab ? '\t'
+                                                                                                                                      : '\0'} {
         }
-        ReadCsvSettings m_settings;
-        bool m_firstLine{true};
         enum class ColumnType {
             kNone,
             kInt,
             kFloat,
-            kString,
-            kUnicode
+            kString
+        };
+        struct Field {
+            std::string_view text;
+            // kNone for an empty field
+            ColumnType type{ColumnType::kNone};
+            np::int_ intValue{0};
+            np::float_ floatValue{0};
+        };
+        // Values of a column in the narrowest type seen so far
+        struct Column {
+            internal::Value name;
+            ColumnType type{ColumnType::kNone};
+            // Number of empty fields before the type of the column is known
+            np::Size missing{0};
+            std::vector<np::int_> ints;
+            std::vector<np::float_> floats;
+            std::vector<np::string_> strings;
         };
-        std::vector<std::pair<internal::Value, ColumnType>> m_headers;
+        ReadCsvSettings m_settings;
+        char m_separator;
+        bool m_firstLine{true};
+        std::vector<Column> m_columns;
+        std::vector<Field> m_fields;
+        // Incomplete last line of the data received so far
         std::string m_buffer;
-        DataFrame m_dataFrame{};
-        np::Size m_totalSamples{0};
-        np::Size m_row{0};
+        np::Size m_rows{0};
     };
 
-    static void processLine(ReadCsvContext *context, const std::string &currentLine) {
+    static std::string_view trim(std::string_view text) {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    static ReadCsvContext::Field parseField(std::string_view text, bool hasDigit, bool hasDot) {
+        ReadCsvContext::Field field{text};
+        auto number = trim(text);
+        if (number.empty()) {
+            return field;
+        }
+        field.type = ReadCsvContext::ColumnType::kString;
+        if (!hasDigit) {
+            return field;
+        }
+        const char *end = number.data() + number.size();
+        if (!hasDot) {
+            auto [ptr, ec] = std::from_chars(number.data(), end, field.intValue);
+            if (ec == std::errc{} && ptr == end) {
+                field.type = ReadCsvContext::ColumnType::kInt;
+                return field;
+            }
+        }
+        auto [ptr, ec] = std::from_chars(number.data(), end, field.floatValue);
+        if (ec == std::errc{} && ptr == end) {
+            field.type = ReadCsvContext::ColumnType::kFloat;
+        }
+        return field;
+    }
+
+    static void setColumnType(ReadCsvContext::Column &column, ReadCsvContext::ColumnType type) {
+        using ColumnType = ReadCsvContext::ColumnType;
+        if (column.type == ColumnType::kNone) {
+            if (type == ColumnType::kFloat) {
+                column.floats.assign(column.missing, std::numeric_limits<np::float_>::quiet_NaN());
+            } else if (type == ColumnType::kString) {
+                column.strings.assign(column.missing, np::string_{});
+            }
+        } else if (column.type == ColumnType::kInt && type == ColumnType::kFloat) {
+            column.floats.assign(column.ints.begin(), column.ints.end());
+            std::vector<np::int_>{}.swap(column.ints);
+        } else {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid column type");
+        }
+        column.type = type;
+    }
+
+    static void appendField(ReadCsvContext::Column &column, const ReadCsvContext::Field &field) {
+        using ColumnType = ReadCsvContext::ColumnType;
+        if (field.type == ColumnType::kNone) {
+            // A missing value: NaN in numeric columns, an empty string in text columns
+            if (column.type == ColumnType::kNone) {
+                ++column.missing;
+                return;
+            }
+            if (column.type == ColumnType::kInt) {
+                setColumnType(column, ColumnType::kFloat);
+            }
+            if (column.type == ColumnType::kFloat) {
+                column.floats.push_back(std::numeric_limits<np::float_>::quiet_NaN());
+            } else {
+                column.strings.emplace_back();
+            }
+            return;
+        }
+
+        auto type = field.type;
+        if (type == ColumnType::kInt && (column.type == ColumnType::kFloat || (column.type == ColumnType::kNone && column.missing > 0))) {
+            type = ColumnType::kFloat;
+        } else if (column.type == ColumnType::kString) {
+            type = ColumnType::kString;
+        }
+        if (type != column.type) {
+            setColumnType(column, type);
+        }
+        switch (column.type) {
+            case ColumnType::kInt:
+                column.ints.push_back(field.intValue);
+                break;
+            case ColumnType::kFloat:
+                column.floats.push_back(field.type == ColumnType::kInt ? static_cast<np::float_>(field.intValue) : field.floatValue);
+                break;
+            case ColumnType::kString:
+                column.strings.emplace_back(field.text);
+                break;
+            case ColumnType::kNone:
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid column type");
+        }
+    }
+
+    static void processLine(ReadCsvContext *context, std::string_view currentLine) {
         // Pregnancies,Glucose,BloodPressure,SkinThickness,Insulin,BMI,DiabetesPedigreeFunction,Age,Outcome
         // 6,148,72,35,0,33.6,0.627,50,1
         // 1,85,66,29,0,26.6,0.351,31,0
         // 8,183,64,0,0,23.3,0.672,32,1
         const ReadCsvSettings &settings = context->m_settings;
 
-        std::vector<internal::Value> columns;
-        auto wordStart = currentLine.begin();
-        auto wordEnd = wordStart;
+        if (!currentLine.empty() && currentLine.back() == '\r') {
+            currentLine.remove_suffix(1);
+        }
+        if (trim(currentLine).empty()) {
+            return;
+        }
+
+        auto &fields = context->m_fields;
+        fields.clear();
         bool hasDigitInLine = false;
         bool hasDotInLine = false;
-        while (wordEnd < currentLine.end() && *wordEnd != '\r') {
-            const char separator = (settings.separator == Separator::kComma ? ',' : settings.separator == Separator::kTab ? '\t'
-                                                                                                                          : '\0');
+        std::size_t wordStart = 0;
+        while (true) {
             bool hasDigitInWord = false;
             bool hasDotInWord = false;
-
-            while (wordEnd != currentLine.end() && *wordEnd != separator && *wordEnd != '\r') {
-                if (!hasDigitInLine && std::isdigit(*wordEnd)) {
-                    hasDigitInLine = true;
-                }
-                if (!hasDigitInWord && std::isdigit(*wordEnd)) {
-                    hasDigitInWord = true;
-                }
-                if (!hasDotInLine && *wordEnd == '.') {
-                    hasDotInLine = true;
-                }
-                if (!hasDotInWord && *wordEnd == '.') {
-                    hasDotInWord = true;
-                }
-
+            std::size_t wordEnd = wordStart;
+            while (wordEnd < currentLine.size() && currentLine[wordEnd] != context->m_separator) {
+                hasDigitInWord |= std::isdigit(static_cast<unsigned char>(currentLine[wordEnd])) != 0;
+                hasDotInWord |= currentLine[wordEnd] == '.';
                 ++wordEnd;
             }
-            std::string word{wordStart, wordEnd};
-            if (hasDigitInWord && hasDotInWord)
-                columns.emplace_back(std::stod(word));
-            else if (hasDigitInWord)
-                columns.emplace_back(std::stol(word));
-            else
-                columns.emplace_back(word);
-            if (wordEnd == currentLine.end()) {
+            hasDigitInLine |= hasDigitInWord;
+            hasDotInLine |= hasDotInWord;
+            fields.push_back(parseField(currentLine.substr(wordStart, wordEnd - wordStart), hasDigitInWord, hasDotInWord));
+            if (wordEnd == currentLine.size()) {
                 break;
             }
             wordStart = wordEnd + 1;
-            wordEnd = wordStart;
         }
-        if (columns.empty())
-            return;
 
-        bool needToAddData = true;
         if (context->m_firstLine) {
-            if (settings.header == Header::kInfer) {
-                if (!hasDigitInLine && !hasDotInLine) {
-                    for (const auto &column: columns) {
-                        context->m_headers.emplace_back(*static_cast<const std::string *>(column), ReadCsvContext::ColumnType::kNone);
-                    }
-                    needToAddData = false;
-                    --context->m_totalSamples;
-                } else {
-                    for (std::size_t i = 0; i < columns.size(); ++i) {
-                        auto columnType = ReadCsvContext::ColumnType::kNone;
-                        if (columns[i].isInt()) {
-                            columnType = ReadCsvContext::ColumnType::kInt;
-                        } else if (columns[i].isFloat()) {
-                            columnType = ReadCsvContext::ColumnType::kFloat;
-                        } else if (columns[i].isString()) {
-                            columnType = ReadCsvContext::ColumnType::kString;
-                        } else if (columns[i].isUnicode()) {
-                            columnType = ReadCsvContext::ColumnType::kUnicode;
-                        } else {
-                            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid column type");
-                        }
-                        context->m_headers.emplace_back(static_cast<np::intc>(i), columnType);
-                    }
-                }
-            } else if (settings.header == Header::kNo) {
-                for (std::size_t i = 0; i < columns.size(); ++i) {
-                    auto columnType = ReadCsvContext::ColumnType::kNone;
-                    if (columns[i].isInt()) {
-                        columnType = ReadCsvContext::ColumnType::kInt;
-                    } else if (columns[i].isFloat()) {
-                        columnType = ReadCsvContext::ColumnType::kFloat;
-                    } else if (columns[i].isString()) {
-                        columnType = ReadCsvContext::ColumnType::kString;
-                    } else if (columns[i].isUnicode()) {
-                        columnType = ReadCsvContext::ColumnType::kUnicode;
-                    } else {
-                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid column type");
-                    }
-                    context->m_headers.emplace_back(static_cast<np::intc>(i), columnType);
+            context->m_firstLine = false;
+            if (settings.header == Header::kInfer && !hasDigitInLine && !hasDotInLine) {
+                for (const auto &field: fields) {
+                    context->m_columns.emplace_back().name = internal::Value{std::string{field.text}};
                 }
-            } else {
+                return;
+            }
+            if (settings.header != Header::kInfer && settings.header != Header::kNo) {
                 PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid settings.header value");
             }
+            for (std::size_t i = 0; i < fields.size(); ++i) {
+                context->m_columns.emplace_back().name = internal::Value{static_cast<np::intc>(i)};
+            }
+        }
+
+        if (fields.size() > context->m_columns.size()) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Too many fields in line " + std::to_string(context->m_rows + 1));
+        }
+        static const ReadCsvContext::Field kMissing{};
+        for (std::size_t i = 0; i < context->m_columns.size(); ++i) {
+            appendField(context->m_columns[i], i < fields.size() ? fields[i] : kMissing);
         }
-        if (needToAddData) {
-            for (std::size_t i = 0; i < columns.size(); ++i) {
-                auto &[columnName, columnType] = context->m_headers[i];
-                if (columnType == ReadCsvContext::ColumnType::kNone) {
-                    if (columns[i].isInt()) {
-                        columnType = ReadCsvContext::ColumnType::kInt;
-                    } else if (columns[i].isFloat()) {
-                        columnType = ReadCsvContext::ColumnType::kFloat;
-                    } else if (columns[i].isString()) {
-                        columnType = ReadCsvContext::ColumnType::kString;
-                    } else if (columns[i].isUnicode()) {
-                        columnType = ReadCsvContext::ColumnType::kUnicode;
-                    } else {
-                        PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid column type");
+        ++context->m_rows;
+    }
+
+    static void feed(ReadCsvContext *context, const char *data, std::size_t size) {
+        const char *end = data + size;
+        while (data < end) {
+            const auto *newLine = static_cast<const char *>(std::memchr(data, '\n', end - data));
+            if (newLine == nullptr) {
+                context->m_buffer.append(data, end);
+                return;
+            }
+            if (context->m_buffer.empty()) {
+                processLine(context, std::string_view{data, static_cast<std::size_t>(newLine - data)});
+            } else {
+                context->m_buffer.append(data, newLine);
+                processLine(context, context->m_buffer);
+                context->m_buffer.clear();
+            }
+            data = newLine + 1;
+        }
+    }
+
+    static DataFrame finish(ReadCsvContext *context) {
+        processLine(context, context->m_buffer);
+        context->m_buffer.clear();
+
+        DataFrame dataFrame{};
+        if (context->m_rows == 0) {
+            return dataFrame;
+        }
+        const np::Size rows = context->m_rows;
+        for (auto &column: context->m_columns) {
+            switch (column.type) {
+                case ReadCsvContext::ColumnType::kInt: {
+                    auto array = np::Array<np::int_>{np::Shape{rows}};
+                    for (np::Size i = 0; i < rows; ++i) {
+                        array.set(i, column.ints[i]);
                     }
+                    std::vector<np::int_>{}.swap(column.ints);
+                    dataFrame.append(Series{std::move(array), column.name});
+                    break;
                 }
-                if (!context->m_dataFrame.hasColumn(columnName)) {
-                    switch (columnType) {
-                        case ReadCsvContext::ColumnType::kInt: {
-                            auto array = np::Array<np::int_>{np::Shape{context->m_totalSamples}};
-                            auto series = Series{array, columnName};
-                            context->m_dataFrame.append(series);
-                            break;
-                        }
-                        case ReadCsvContext::ColumnType::kFloat: {
-                            auto array = np::Array<np::float_>{np::Shape{context->m_totalSamples}};
-                            auto series = Series{array, columnName};
-                            context->m_dataFrame.append(series);
-                            break;
-                        }
-                        case ReadCsvContext::ColumnType::kString: {
-                            auto array = np::Array<np::string_>{np::Shape{context->m_totalSamples}};
-                            auto series = Series{array, columnName};
-                            context->m_dataFrame.append(series);
-                            break;
-                        }
-                        case ReadCsvContext::ColumnType::kUnicode: {
-                            auto array = np::Array<np::unicode_>{np::Shape{context->m_totalSamples}};
-                            auto series = Series{array, columnName};
-                            context->m_dataFrame.append(series);
-                            break;
-                        }
-                        case ReadCsvContext::ColumnType::kNone:
-                            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Invalid column type");
+                case ReadCsvContext::ColumnType::kNone:
+                    // Only empty fields
+                    setColumnType(column, ReadCsvContext::ColumnType::kFloat);
+                    [[fallthrough]];
+                case ReadCsvContext::ColumnType::kFloat: {
+                    auto array = np::Array<np::float_>{np::Shape{rows}};
+                    for (np::Size i = 0; i < rows; ++i) {
+                        array.set(i, column.floats[i]);
+                    }
+                    std::vector<np::float_>{}.swap(column.floats);
+                    dataFrame.append(Series{std::move(array), column.name});
+                    break;
+                }
+                case ReadCsvContext::ColumnType::kString: {
+                    auto array = np::Array<np::string_>{np::Shape{rows}};
+                    for (np::Size i = 0; i < rows; ++i) {
+                        array.set(i, std::move(column.strings[i]));
                     }
+                    std::vector<np::string_>{}.swap(column.strings);
+                    dataFrame.append(Series{std::move(array), column.name});
+                    break;
                 }
-                context->m_dataFrame.set(context->m_row, columnName, columns.at(i));
             }
         }
-        if (needToAddData) {
-            ++context->m_row;
+        return dataFrame;
+    }
+
+    using namespace internal::httpreader;
+
+    // Receives the file piece by piece as it is read
+    using ReadCsvConsumer = std::function<void(const char *data, std::size_t size)>;
+
+    static void readLocal(const std::string &filepath, const ReadCsvConsumer &consume) {
+        std::ifstream stream{filepath, std::ios::in | std::ios::binary};
+        if (!stream.is_open()) {
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot open file " + filepath);
         }
-        if (context->m_firstLine) {
-            context->m_firstLine = false;
+        static const constexpr std::size_t kChunkSize = 1024 * 1024;
+        std::vector<char> chunk(kChunkSize);
+        while (stream) {
+            stream.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            consume(chunk.data(), static_cast<std::size_t>(stream.gcount()));
         }
     }
 
-    using namespace internal::httpreader;
+    // An uncompressed body of known length is worth downloading in parallel ranges when the server supports them
+    static bool isRangeable(const HttpMessage &response, std::size_t rangeSize) {
+        return response.m_statusCode == HttpMessage::StatusCodes::kOk && response.m_acceptRanges && !response.m_chunked &&
+               response.m_contentEncoding == HttpMessage::ContentEncoding::kIdentity && response.m_contentLength > rangeSize;
+    }
 
-    template<typename TInitializer, typename THandler>
-    static void readWeb(const Uri &uri, ReadCsvContext *context) {
-        TInitializer initializer;
-        Uri uriLocal{uri};
+    // Downloads the file with a GET request that accepts a compressed body, following redirects. With a
+    // rangeSize a rangeable body is cut off after rangeSize bytes, so that the rest can come in ranges.
+    template<typename THandler>
+    static std::shared_ptr<THandler> requestFile(Uri *uri, std::chrono::milliseconds timeout, std::size_t rangeSize,
+                                                 const CacheValidators &validators, const ReadCsvConsumer &consume) {
         int redirectCount = 0;
         int kMaxRedirectCount = 5;
         bool redirect = false;
+        std::shared_ptr<THandler> handler;
         do {
-            Poll poll;
-            auto handler = std::make_shared<THandler>(
+            redirect = false;
+            std::size_t received = 0;
+            Poll poll{timeout};
+            handler = std::make_shared<THandler>(
                     "pd",
-                    uriLocal,
-                    [context](const std::vector<char> &buffer) {
-                        context->m_buffer += std::string(buffer.data(), buffer.size());
+                    *uri,
+                    [&handler, &consume, &received, rangeSize](const char *data, std::size_t size) {
+                        if (rangeSize > 0 && isRangeable(*handler->response(), rangeSize)) {
+                            size = std::min(size, rangeSize - received);
+                            received += size;
+                            if (received == rangeSize) {
+                                handler->stop();
+                            }
+                        }
+                        if (size > 0) {
+                            consume(data, size);
+                        }
                     },
-                    [&uriLocal, &redirect](const std::string &url) {
-                        uriLocal.m_url = url;
+                    [uri, &redirect](const std::string &url) {
+                        uri->m_url = url;
                         redirect = true;
-                    });
+                    },
+                    HttpMessage::Method::kGet, std::nullopt, validators);
             poll.addHandler(handler);
             poll.run();
         } while (redirect && redirectCount++ < kMaxRedirectCount);
+        return handler;
     }
 
-    static void readFtp(const Uri &uri, ReadCsvContext *context) {
+    template<typename TInitializer, typename THandler>
+    static void readWeb(const std::string &filepath, const Uri &uri, const ReadCsvSettings &settings, const ReadCsvConsumer &consume) {
+        TInitializer initializer;
+        Uri uriLocal{uri};
+
+        std::optional<HttpCache> cache;
+        std::optional<HttpCache::Entry> cached;
+        if (!settings.cacheDirectory.empty()) {
+            cache.emplace(settings.cacheDirectory);
+            cached = cache->find(filepath);
+        }
+        CacheValidators validators = cached ? cached->validators : CacheValidators{};
+        std::optional<HttpCache::Writer> writer;
+        if (cache) {
+            writer.emplace(*cache, filepath);
+        }
+        auto onData = [&consume, &writer](const char *data, std::size_t size) {
+            consume(data, size);
+            if (writer) {
+                writer->write(data, size);
+            }
+        };
+
+        // The file is requested whole, so the server may compress it. Only a large file sent uncompressed
+        // is switched to parallel ranges after its first rangeSize bytes.
+        std::size_t rangeSize = settings.connections > 1 ? std::max<std::size_t>(settings.rangeSize, 1) : 0;
+        auto handler = requestFile<THandler>(&uriLocal, settings.timeout, rangeSize, validators, onData);
+        if (handler->response() == nullptr) {
+            return;
+        }
+        HttpMessage response = *handler->response();
+        // The cut off connection is closed before the ranges are requested
+        handler.reset();
+        if (cached && response.m_statusCode == HttpMessage::StatusCodes::kNotModified) {
+            writer.reset();
+            readLocal(cached->body.string(), consume);
+            return;
+        }
+        if (rangeSize > 0 && isRangeable(response, rangeSize)) {
+            RangeDownloader<THandler> downloader{uriLocal, rangeSize, response.m_contentLength, settings.connections, rangeSize,
+                                                 response.m_validators, settings.timeout};
+            downloader.run(onData);
+        }
+        if (writer && response.m_statusCode == HttpMessage::StatusCodes::kOk) {
+            writer->commit(response.m_validators);
+        }
+    }
+
+    static void readFtp(const Uri &uri, const ReadCsvSettings &settings, const ReadCsvConsumer &consume) {
         Initializer initializer;
-        Poll poll;
+        Poll poll{settings.timeout};
         auto handler = std::make_shared<HttpHandler>(
                 "pd",
                 uri,
-                [context](const std::vector<char> &buffer) {
-                    context->m_buffer += std::string(buffer.data(), buffer.size());
-                },
+                consume,
                 [](const std::string &) {
                 });
         poll.addHandler(handler);
         poll.run();
     }
 
-    static void readLocal(const std::string &filepath, ReadCsvContext *context) {
-        std::filesystem::path path{filepath};
-        std::fstream stream;
-        stream.open(filepath, std::ios::in);
-        if (!stream.is_open()) {
-            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Cannot open file " + filepath);
+    static void readSource(const std::string &filepath, const ReadCsvSettings &settings, const ReadCsvConsumer &consume) {
+        Uri uri = parseUri(filepath);
+        if (uri.m_scheme == Scheme::kHttp) {
+            readWeb<Initializer, HttpHandler>(filepath, uri, settings, consume);
+        } else if (uri.m_scheme == Scheme::kHttps) {
+#ifdef OPENSSL
+            readWeb<SslInitializer, HttpsHandler>(filepath, uri, settings, consume);
+#else
+            PD_THROW_WITH_STACKTRACE(std::runtime_error, "SSL support is not enabled");
+#endif
+        } else if (uri.m_scheme == Scheme::kFtp) {
+            readFtp(uri, settings, consume);
+        } else {
+            readLocal(filepath, consume);
         }
-        stream.seekg(0, std::ios::end);
-        auto size = stream.tellg();
-        context->m_buffer.resize(size);
-        stream.seekg(0);
-        stream.read(&context->m_buffer[0], size);
     }
 
     DataFrame read_csv(const std::string &filepath, const ReadCsvSettings &settings) {
@@ -267,39 +464,261 @@ namespace pd {
             return DataFrame{};
         }
         ReadCsvContext context{settings};
+        readSource(filepath, settings, [&context](const char *data, std::size_t size) {
+            feed(&context, data, size);
+        });
+        return finish(&context);
+    }
 
-        using namespace internal::httpreader;
-        Uri uri = parseUri(filepath);
-        if (uri.m_scheme == Scheme::kHttp) {
-            readWeb<Initializer, HttpHandler>(uri, &context);
-        } else if (uri.m_scheme == Scheme::kHttps) {
+    std::future<DataFrame> read_csv_async(const std::string &filepath, const ReadCsvSettings &settings) {
+        return std::async(std::launch::async, [filepath, settings]() {
+            if (filepath.empty()) {
+                return DataFrame{};
+            }
+            // The file is read on its own thread and handed over to the parser through the ring buffer,
+            // so parsing starts with the first bytes received and a slow parser slows the reading down
+            static const constexpr std::size_t kPipelineBufferSize = 4 * 1024 * 1024;
+            internal::SpscRingBuffer buffer{kPipelineBufferSize};
+            std::exception_ptr readError;
+            std::thread reader{[&filepath, &settings, &buffer, &readError]() {
+                try {
+                    readSource(filepath, settings, [&buffer](const char *data, std::size_t size) {
+                        if (!buffer.write(data, size)) {
+                            PD_THROW_WITH_STACKTRACE(std::runtime_error, "Parsing has stopped");
+                        }
+                    });
+                } catch (...) {
+                    readError = std::current_exception();
+                }
+                buffer.close();
+            }};
+
+            ReadCsvContext context{settings};
+            try {
+                while (buffer.read([&context](const char *data, std::size_t size) {
+                    feed(&context, data, size);
+                })) {
+                }
+            } catch (...) {
+                buffer.stop();
+                reader.join();
+                throw;
+            }
+            reader.join();
+            if (readError) {
+                std::rethrow_exception(readError);
+            }
+            return finish(&context);
+        });
+    }
+
+    // A source of read_csv_many. Data received from the network waits in m_pending until a worker parses it.
+    struct ReadCsvSource {
+        ReadCsvSource(std::string path, const ReadCsvSettings &settings)
+            : m_path{std::move(path)}, m_context{settings} {
+        }
+        std::string m_path;
+        ReadCsvContext m_context;
+        std::string m_pending;
+        // Queued or being parsed by a worker
+        bool m_scheduled{false};
+        int m_redirectCount{0};
+        std::exception_ptr m_error;
+    };
+
+    // Pool of threads parsing the sources of read_csv_many. A source is parsed by one worker at a time,
+    // so its data is fed to the parser in the order it arrived.
+    class ParseWorkers {
+    public:
+        explicit ParseWorkers(std::vector<std::unique_ptr<ReadCsvSource>> &sources)
+            : m_sources{sources} {
+        }
+
+        ParseWorkers(const ParseWorkers &) = delete;
+        ParseWorkers &operator=(const ParseWorkers &) = delete;
+
+        ~ParseWorkers() {
+            finish();
+        }
+
+        void start(std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                m_threads.emplace_back([this]() {
+                    work();
+                });
+            }
+        }
+
+        // A local file is read and parsed by a worker as one task
+        void scheduleFile(std::size_t source) {
+            std::lock_guard lock{m_mutex};
+            m_sources[source]->m_scheduled = true;
+            m_tasks.push_back(Task{source, true});
+            m_condition.notify_one();
+        }
+
+        void push(std::size_t source, const char *data, std::size_t size) {
+            std::lock_guard lock{m_mutex};
+            auto &state = *m_sources[source];
+            state.m_pending.append(data, size);
+            if (!state.m_scheduled) {
+                state.m_scheduled = true;
+                m_tasks.push_back(Task{source, false});
+                m_condition.notify_one();
+            }
+        }
+
+        // Waits for all the scheduled work
+        void finish() {
+            {
+                std::lock_guard lock{m_mutex};
+                m_closed = true;
+            }
+            m_condition.notify_all();
+            for (auto &thread: m_threads) {
+                thread.join();
+            }
+            m_threads.clear();
+        }
+
+    private:
+        struct Task {
+            std::size_t source;
+            bool file;
+        };
+
+        void work() {
+            std::unique_lock lock{m_mutex};
+            while (true) {
+                m_condition.wait(lock, [this]() {
+                    return !m_tasks.empty() || m_closed;
+                });
+                if (m_tasks.empty()) {
+                    return;
+                }
+                auto task = m_tasks.front();
+                m_tasks.pop_front();
+                auto &source = *m_sources[task.source];
+                if (task.file) {
+                    lock.unlock();
+                    run(source, [&source]() {
+                        readLocal(source.m_path, [&source](const char *data, std::size_t size) {
+                            feed(&source.m_context, data, size);
+                        });
+                    });
+                    lock.lock();
+                    source.m_scheduled = false;
+                    continue;
+                }
+                std::string data;
+                while (true) {
+                    data.clear();
+                    data.swap(source.m_pending);
+                    if (data.empty()) {
+                        source.m_scheduled = false;
+                        break;
+                    }
+                    lock.unlock();
+                    run(source, [&source, &data]() {
+                        feed(&source.m_context, data.data(), data.size());
+                    });
+                    lock.lock();
+                }
+            }
+        }
+
+        template<typename Function>
+        static void run(ReadCsvSource &source, Function &&function) {
+            if (source.m_error) {
+                return;
+            }
+            try {
+                function();
+            } catch (...) {
+                source.m_error = std::current_exception();
+            }
+        }
+
+        std::vector<std::unique_ptr<ReadCsvSource>> &m_sources;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<Task> m_tasks;
+        bool m_closed{false};
+        std::vector<std::thread> m_threads;
+    };
+
+    static void startDownload(Poll &poll, ParseWorkers &workers, ReadCsvSource &source, std::size_t index, const Uri &uri) {
+        auto onData = [&workers, index](const char *data, std::size_t size) {
+            workers.push(index, data, size);
+        };
+        auto onRedirect = [&poll, &workers, &source, index, uri](const std::string &url) {
+            static const constexpr int kMaxRedirectCount = 5;
+            if (source.m_redirectCount++ >= kMaxRedirectCount) {
+                PD_THROW_WITH_STACKTRACE(std::runtime_error, "Too many redirects for " + source.m_path);
+            }
+            Uri redirected{uri};
+            redirected.m_url = url;
+            startDownload(poll, workers, source, index, redirected);
+        };
+        if (uri.m_scheme == Scheme::kHttps) {
 #ifdef OPENSSL
-            readWeb<SslInitializer, HttpsHandler>(uri, &context);
+            poll.addHandler(std::make_shared<HttpsHandler>("pd", uri, onData, onRedirect));
 #else
             PD_THROW_WITH_STACKTRACE(std::runtime_error, "SSL support is not enabled");
 #endif
-        } else if (uri.m_scheme == Scheme::kFtp) {
-            readFtp(uri, &context);
         } else {
-            readLocal(filepath, &context);
+            poll.addHandler(std::make_shared<HttpHandler>("pd", uri, onData, onRedirect));
+        }
+    }
+
+    std::vector<DataFrame> read_csv_many(const std::vector<std::string> &paths, const ReadCsvSettings &settings) {
+        std::vector<std::unique_ptr<ReadCsvSource>> sources;
+        sources.reserve(paths.size());
+        bool https = false;
+        for (const auto &path: paths) {
+            sources.push_back(std::make_unique<ReadCsvSource>(path, settings));
+            https = https || parseUri(path).m_scheme == Scheme::kHttps;
         }
 
-        std::string currentLine;
+        Initializer initializer;
+#ifdef OPENSSL
+        std::optional<SslInitializer> sslInitializer;
+        if (https) {
+            sslInitializer.emplace();
+        }
+#endif
         {
-            std::stringstream stream(context.m_buffer);
-            context.m_totalSamples = 0;
-            while (std::getline(stream, currentLine)) {
-                bool whiteSpacesOnly = std::all_of(currentLine.begin(), currentLine.end(), isspace);
-                if (!whiteSpacesOnly)
-                    ++context.m_totalSamples;
+            ParseWorkers workers{sources};
+            workers.start(std::min<std::size_t>(internal::threadCount(), sources.size()));
+            Poll poll{settings.timeout};
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                if (paths[i].empty()) {
+                    continue;
+                }
+                Uri uri = parseUri(paths[i]);
+                if (uri.m_scheme == Scheme::kNone) {
+                    workers.scheduleFile(i);
+                } else {
+                    startDownload(poll, workers, *sources[i], i, uri);
+                }
             }
+            // An exception leaves the scope only after the workers have stopped
+            poll.run();
         }
-        {
-            std::stringstream stream(context.m_buffer);
-            while (std::getline(stream, currentLine)) {
-                processLine(&context, currentLine);
+
+        for (const auto &source: sources) {
+            if (source->m_error) {
+                std::rethrow_exception(source->m_error);
             }
         }
-        return context.m_dataFrame;
+        std::vector<DataFrame> frames(sources.size());
+        internal::parallelFor(static_cast<np::Size>(sources.size()), 1, [&](np::Size, np::Size begin, np::Size end) {
+            for (np::Size i = begin; i < end; ++i) {
+                if (!paths[i].empty()) {
+                    frames[i] = finish(&sources[i]->m_context);
+                }
+            }
+        });
+        return frames;
     }
 }// namespace pd
@@ -0,0 +1,401 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+// Built on POSIX sockets, so the server and the tests using it are left out on Windows
+#ifndef _WIN32
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
+#ifdef OPENSSL
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#endif
+
+// Minimal HTTP/1.1 server on 127.0.0.1 serving one body for any path. Understands GET, HEAD,
+// single Range requests, If-Range, If-None-Match and optionally gzip and keeps connections alive, so it can stand in for a remote host in tests
+// and benchmarks of the downloader. With TLS it serves https with a self-signed certificate made at startup.
+class TestHttpServer {
+public:
+    enum class Transport {
+        kPlain,
+        kTls
+    };
+
+    explicit TestHttpServer(std::string body, bool acceptRanges = true, Transport transport = Transport::kPlain)
+        : m_body{std::make_shared<const std::string>(std::move(body))}, m_acceptRanges{acceptRanges} {
+        if (transport == Transport::kTls) {
+#ifdef OPENSSL
+            m_context = createContext();
+#else
+            throw std::runtime_error("SSL support is not enabled");
+#endif
+        }
+        m_listener = ::socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        ::setsockopt(m_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t length = sizeof(address);
+        if (::bind(m_listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+            ::listen(m_listener, SOMAXCONN) != 0 ||
+            ::getsockname(m_listener, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+            ::close(m_listener);
+#ifdef OPENSSL
+            SSL_CTX_free(m_context);
+#endif
+            throw std::runtime_error("Cannot start test HTTP server");
+        }
+        m_port = ntohs(address.sin_port);
+        m_acceptThread = std::thread{[this]() {
+            acceptLoop();
+        }};
+    }
+
+    TestHttpServer(const TestHttpServer &) = delete;
+    TestHttpServer &operator=(const TestHttpServer &) = delete;
+
+    ~TestHttpServer() {
+        m_stopped = true;
+        ::shutdown(m_listener, SHUT_RDWR);
+        m_acceptThread.join();
+        ::close(m_listener);
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard lock{m_mutex};
+            for (int client: m_clients) {
+                ::shutdown(client, SHUT_RDWR);
+            }
+            workers.swap(m_workers);
+        }
+        for (auto &worker: workers) {
+            worker.join();
+        }
+#ifdef OPENSSL
+        SSL_CTX_free(m_context);
+#endif
+    }
+
+    [[nodiscard]] std::string url(const std::string &path = "/data.csv") const {
+#ifdef OPENSSL
+        if (m_context != nullptr) {
+            return "https://127.0.0.1:" + std::to_string(m_port) + path;
+        }
+#endif
+        return "http://127.0.0.1:" + std::to_string(m_port) + path;
+    }
+
+    // Holds every response back for the given time to simulate a stalled server
+    void setResponseDelay(std::chrono::milliseconds delay) {
+        m_responseDelay = delay;
+    }
+
+    // Replaces the body served from now on together with its entity tag; an empty tag sends no ETag
+    void setBody(std::string body, std::string etag = {}) {
+        std::lock_guard lock{m_mutex};
+        m_body = std::make_shared<const std::string>(std::move(body));
+        m_etag = std::move(etag);
+    }
+
+    // Sends whole bodies gzip compressed to clients that accept it
+    void setGzip(bool gzip) {
+        m_gzip = gzip;
+    }
+
+    // Closes the connection instead of answering the next requests, like a server dropping an idle connection
+    void dropRequests(std::size_t count) {
+        m_droppedRequests = count;
+    }
+
+    [[nodiscard]] std::size_t connections() const {
+        return m_connections;
+    }
+
+    [[nodiscard]] std::size_t requests() const {
+        return m_requests;
+    }
+
+    [[nodiscard]] std::size_t rangeRequests() const {
+        return m_rangeRequests;
+    }
+
+    [[nodiscard]] std::size_t notModifiedResponses() const {
+        return m_notModifiedResponses;
+    }
+
+    [[nodiscard]] std::size_t gzipResponses() const {
+        return m_gzipResponses;
+    }
+
+    // TLS handshakes that resumed a session of an earlier connection
+    [[nodiscard]] std::size_t resumedSessions() const {
+        return m_resumedSessions;
+    }
+
+private:
+    // A client connection, encrypted when the server runs TLS
+    struct Connection {
+        int socket;
+#ifdef OPENSSL
+        SSL *ssl{nullptr};
+#endif
+
+        [[nodiscard]] long receive(char *data, std::size_t size) const {
+#ifdef OPENSSL
+            if (ssl != nullptr) {
+                return SSL_read(ssl, data, static_cast<int>(size));
+            }
+#endif
+            return ::recv(socket, data, size, 0);
+        }
+
+        // The whole response at once: over TLS it goes out as full-size records
+        [[nodiscard]] bool send(const std::string &response) const {
+#ifdef OPENSSL
+            if (ssl != nullptr) {
+                return SSL_write(ssl, response.data(), static_cast<int>(response.size())) == static_cast<int>(response.size());
+            }
+#endif
+            std::size_t sent = 0;
+            while (sent < response.size()) {
+                auto count = ::send(socket, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+                if (count <= 0) {
+                    return false;
+                }
+                sent += static_cast<std::size_t>(count);
+            }
+            return true;
+        }
+    };
+
+#ifdef OPENSSL
+    // Server context with a new P-256 key and a self-signed certificate for it
+    static SSL_CTX *createContext() {
+        EVP_PKEY *key = nullptr;
+        EVP_PKEY_CTX *keyContext = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        bool generated = keyContext != nullptr && EVP_PKEY_keygen_init(keyContext) == 1 &&
+                         EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyContext, NID_X9_62_prime256v1) == 1 &&
+                         EVP_PKEY_keygen(keyContext, &key) == 1;
+        EVP_PKEY_CTX_free(keyContext);
+        if (!generated) {
+            throw std::runtime_error("Cannot generate the test server key");
+        }
+
+        X509 *certificate = X509_new();
+        X509_set_version(certificate, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+        X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+        X509_gmtime_adj(X509_getm_notAfter(certificate), 24 * 60 * 60);
+        X509_set_pubkey(certificate, key);
+        X509_NAME *name = X509_get_subject_name(certificate);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char *>("127.0.0.1"), -1, -1, 0);
+        X509_set_issuer_name(certificate, name);
+
+        SSL_CTX *context = SSL_CTX_new(TLS_server_method());
+        bool ready = X509_sign(certificate, key, EVP_sha256()) != 0 && context != nullptr &&
+                     SSL_CTX_use_certificate(context, certificate) == 1 && SSL_CTX_use_PrivateKey(context, key) == 1;
+        X509_free(certificate);
+        EVP_PKEY_free(key);
+        if (!ready) {
+            SSL_CTX_free(context);
+            throw std::runtime_error("Cannot create the test server certificate");
+        }
+        return context;
+    }
+#endif
+
+    void acceptLoop() {
+        while (!m_stopped) {
+            int client = ::accept(m_listener, nullptr, nullptr);
+            if (client < 0) {
+                continue;
+            }
+            ++m_connections;
+            std::lock_guard lock{m_mutex};
+            m_clients.push_back(client);
+            m_workers.emplace_back([this, client]() {
+                serve(client);
+                ::close(client);
+            });
+        }
+    }
+
+    void serve(int client) {
+        Connection connection{client};
+#ifdef OPENSSL
+        if (m_context != nullptr) {
+            connection.ssl = SSL_new(m_context);
+            SSL_set_fd(connection.ssl, client);
+            if (SSL_accept(connection.ssl) != 1) {
+                SSL_free(connection.ssl);
+                return;
+            }
+            if (SSL_session_reused(connection.ssl) == 1) {
+                ++m_resumedSessions;
+            }
+        }
+#endif
+        exchange(connection);
+#ifdef OPENSSL
+        SSL_free(connection.ssl);
+#endif
+    }
+
+    void exchange(const Connection &connection) {
+        std::string buffer;
+        char data[16 * 1024];
+        while (!m_stopped) {
+            auto end = buffer.find("\r\n\r\n");
+            if (end == std::string::npos) {
+                auto count = connection.receive(data, sizeof(data));
+                if (count <= 0) {
+                    return;
+                }
+                buffer.append(data, static_cast<std::size_t>(count));
+                continue;
+            }
+            // With the line end of the last header field
+            std::string request = buffer.substr(0, end + 2);
+            buffer.erase(0, end + 4);
+            ++m_requests;
+            if (m_droppedRequests > 0) {
+                --m_droppedRequests;
+                return;
+            }
+            std::this_thread::sleep_for(m_responseDelay.load());
+            if (!connection.send(respond(request))) {
+                return;
+            }
+        }
+    }
+
+    std::string respond(const std::string &request) {
+        std::shared_ptr<const std::string> body;
+        std::string etag;
+        {
+            std::lock_guard lock{m_mutex};
+            body = m_body;
+            etag = m_etag;
+        }
+        if (!etag.empty() && request.find("\r\nIf-None-Match: " + etag + "\r\n") != std::string::npos) {
+            ++m_notModifiedResponses;
+            return "HTTP/1.1 304 Not Modified\r\nETag: " + etag + "\r\n\r\n";
+        }
+        bool head = request.compare(0, 5, "HEAD ") == 0;
+        std::size_t first = 0;
+        std::size_t last = body->size() - 1;
+        bool range = false;
+        auto rangePos = request.find("\r\nRange: bytes=");
+        // A range of another version than the current one gets the whole body
+        auto ifRangePos = request.find("\r\nIf-Range: ");
+        bool current = ifRangePos == std::string::npos || request.compare(ifRangePos + 12, etag.size() + 2, etag + "\r\n") == 0;
+        if (rangePos != std::string::npos && m_acceptRanges && current) {
+            auto spec = request.substr(rangePos + 15);
+            first = std::stoul(spec);
+            last = std::min(std::stoul(spec.substr(spec.find('-') + 1)), body->size() - 1);
+            range = true;
+            ++m_rangeRequests;
+        }
+        std::string response = range ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n";
+        if (range) {
+            response += "Content-Range: bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" + std::to_string(body->size()) + "\r\n";
+        }
+        if (m_acceptRanges) {
+            response += "Accept-Ranges: bytes\r\n";
+        }
+        if (!etag.empty()) {
+            response += "ETag: " + etag + "\r\n";
+        }
+        auto encodingPos = request.find("\r\nAccept-Encoding: ");
+        if (m_gzip && !range && encodingPos != std::string::npos && request.find("gzip", encodingPos) < request.find("\r\n", encodingPos + 2)) {
+            std::string compressed = gzip(*body);
+            ++m_gzipResponses;
+            response += "Content-Encoding: gzip\r\nContent-Length: " + std::to_string(compressed.size()) + "\r\n\r\n";
+            return head ? response : response + compressed;
+        }
+        response += "Content-Length: " + std::to_string(last - first + 1) + "\r\n\r\n";
+        if (!head) {
+            response.append(*body, first, last - first + 1);
+        }
+        return response;
+    }
+
+    static std::string gzip(const std::string &text) {
+        z_stream stream{};
+        deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY);
+        std::string compressed(deflateBound(&stream, text.size()), '\0');
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(text.data()));
+        stream.avail_in = static_cast<uInt>(text.size());
+        stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+        stream.avail_out = static_cast<uInt>(compressed.size());
+        deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+        return compressed;
+    }
+
+    std::shared_ptr<const std::string> m_body;
+    std::string m_etag;
+    bool m_acceptRanges;
+    std::atomic_bool m_gzip{false};
+    int m_listener{-1};
+    std::uint16_t m_port{0};
+    std::atomic_bool m_stopped{false};
+    std::atomic<std::chrono::milliseconds> m_responseDelay{std::chrono::milliseconds{0}};
+    std::atomic<std::size_t> m_connections{0};
+    std::atomic<std::size_t> m_requests{0};
+    std::atomic<std::size_t> m_rangeRequests{0};
+    std::atomic<std::size_t> m_notModifiedResponses{0};
+    std::atomic<std::size_t> m_gzipResponses{0};
+    std::atomic<std::size_t> m_droppedRequests{0};
+    std::atomic<std::size_t> m_resumedSessions{0};
+#ifdef OPENSSL
+    SSL_CTX *m_context{nullptr};
+#endif
+    std::mutex m_mutex;
+    std::vector<int> m_clients;
+    std::vector<std::thread> m_workers;
+    std::thread m_acceptThread;
+};
+
+#endif
@@ -0,0 +1,80 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pd/concat.hpp>
+#include <pd/read_csv.hpp>
+
+#include <PdTest.hpp>
+
+using namespace pd;
+
+class ConcatTest : public PdTest {
+};
+
+TEST_F(ConcatTest, rowsTest) {
+    DataFrame df1;
+    df1.append(Series{np::Array<np::int_>{1, 2}, "a"});
+    df1.append(Series{np::Array<np::string_>{"x", "y"}, "b"});
+    DataFrame df2;
+    df2.append(Series{np::Array<np::float_>{0.5}, "a"});
+    df2.append(Series{np::Array<np::string_>{"z"}, "b"});
+    df2.append(Series{np::Array<np::int_>{7}, "c"});
+
+    auto result = concat({df1, df2});
+    EXPECT_EQ(result.shape(), (np::Shape{3, 3}));
+    EXPECT_EQ(result.columns().getIndex(), (std::vector<internal::Value>{"a", "b", "c"}));
+    EXPECT_EQ(result["a"], (Series{np::Array<np::float_>{1.0, 2.0, 0.5}, "a"}));
+    EXPECT_EQ(result["b"], (Series{np::Array<np::string_>{"x", "y", "z"}, "b"}));
+    EXPECT_EQ(result["c"], (Series{np::Array<np::float_>{np::NaN, np::NaN, 7.0}, "c"}));
+
+    // Strings missing from a frame become values with NaN
+    DataFrame onlyA;
+    onlyA.append(df1["a"]);
+    auto reversed = concat({df2, onlyA});
+    EXPECT_EQ(reversed["b"].dtype(), "value");
+    EXPECT_EQ(reversed["a"], (Series{np::Array<np::float_>{0.5, 1.0, 2.0}, "a"}));
+}
+
+TEST_F(ConcatTest, batchesTest) {
+    auto df = read_csv(getTestFile("diabetes.csv").string());
+    std::vector<DataFrame> batches;
+    for (np::Size begin = 0; begin < 768; begin += 100) {
+        std::vector<np::Size> rows;
+        for (np::Size row = begin; row < std::min<np::Size>(begin + 100, 768); ++row) {
+            rows.push_back(row);
+        }
+        batches.push_back(df.take(rows));
+    }
+    auto result = concat(std::move(batches));
+    EXPECT_EQ(result, df);
+}
+
+TEST_F(ConcatTest, columnsTest) {
+    DataFrame df1;
+    df1.append(Series{np::Array<np::int_>{1, 2}, "a"});
+    DataFrame df2;
+    df2.append(Series{np::Array<np::float_>{0.5, 1.5}, "b"});
+    auto result = concat({df1, df2}, Axis::kColumns);
+    EXPECT_EQ(result.shape(), (np::Shape{2, 2}));
+    EXPECT_EQ(result["b"], df2["b"]);
+    EXPECT_THROW(concat({df1, df1}, Axis::kColumns), std::runtime_error);
+}
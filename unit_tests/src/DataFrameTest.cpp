@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <cmath>
 #include <sstream>
 
 #include <pd/core/frame/DataFrame/DataFrame.hpp>
@@ -400,3 +401,263 @@ TEST_F(DataFrameTest, dotTest) {
     auto result = df1.dot(df2);
     EXPECT_DOUBLE_EQ(static_cast<np::float_>(result), 8.0);
 }
+
+TEST_F(DataFrameTest, evalTest) {
+    DataFrame df;
+    df.append(Series{np::Array<np::float_>{1.0, 2.0, 0.0, 1.0}, "a"});
+    df.append(Series{np::Array<np::int_>{-1, 0, 1, 1}, "b"});
+    df.append(Series{np::Array<np::float_>{2.0, 0.0, -1.0, -1.0}, "c"});
+    auto result = df.eval("(a + b) * c - -a / 2");
+    EXPECT_EQ(result.size(), 4);
+    EXPECT_EQ(result.dtype(), "float64");
+    np::float_ expected[4] = {0.5, 1.0, -1.0, -1.5};
+    for (np::Size i = 0; i < 4; ++i) {
+        EXPECT_DOUBLE_EQ(static_cast<np::float_>(result.at(i)), expected[i]);
+    }
+
+    auto diabetes = read_csv(getTestFile("diabetes.csv").string());
+    auto bmi = diabetes.eval("BMI * 2.5 + `Age` - Outcome");
+    EXPECT_EQ(bmi.size(), 768);
+    for (np::Size i = 0; i < 768; i += 97) {
+        auto expectedBmi = static_cast<np::float_>(diabetes.at(i, "BMI")) * 2.5 + static_cast<np::float_>(static_cast<np::int_>(diabetes.at(i, "Age"))) - static_cast<np::float_>(static_cast<np::int_>(diabetes.at(i, "Outcome")));
+        EXPECT_DOUBLE_EQ(static_cast<np::float_>(bmi.at(i)), expectedBmi);
+    }
+
+    // Row labels are kept
+    np::float_ labelled[3][2] = {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+    std::vector<internal::Value> rows{"x", "y", "z"};
+    DataFrame labelledDf{np::Array<np::float_>{labelled}, DataFrameParameters{rows, {"a", "b"}}};
+    auto sum = labelledDf.eval("a + b");
+    EXPECT_EQ(sum.index().getIndex(), rows);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(sum.at(2)), 11.0);
+
+    EXPECT_THROW(static_cast<void>(df.eval("a + d")), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(df.eval("(a + b")), std::runtime_error);
+}
+
+TEST_F(DataFrameTest, rollingTest) {
+    auto df = read_csv(getTestFile("diabetes.csv").string());
+    auto result = df.rolling(5).mean();
+    EXPECT_EQ(result.shape(), df.shape());
+    EXPECT_EQ(result.columns().getIndex(), df.columns().getIndex());
+    EXPECT_TRUE(std::isnan(static_cast<np::float_>(result.at(3, "Glucose"))));
+    np::float_ sum = 0.0;
+    for (np::Size row = 100; row < 105; ++row) {
+        sum += static_cast<np::float_>(static_cast<np::int_>(df.at(row, "Glucose")));
+    }
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(result.at(104, "Glucose")), sum / 5.0);
+    auto maximum = df.expanding().max();
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(maximum.at(767, "Age")), 81.0);
+
+    np::float_ labelled[3][2] = {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+    std::vector<internal::Value> rows{"x", "y", "z"};
+    auto rolling = DataFrame{np::Array<np::float_>{labelled}, DataFrameParameters{rows, {"a", "b"}}}.rolling(2);
+    auto sums = rolling.sum();
+    EXPECT_EQ(sums.index().getIndex(), rows);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(sums.at(2, "b")), 10.0);
+}
+
+TEST_F(DataFrameTest, duplicatedTest) {
+    DataFrame df;
+    df.append(Series{np::Array<np::int_>{1, 2, 1, 1, 2}, "a"});
+    df.append(Series{np::Array<np::string_>{"x", "y", "x", "y", "y"}, "b"});
+    EXPECT_EQ(df.duplicated(), (Series{np::Array<np::bool_>{false, false, true, false, true}}));
+    auto unique = df.drop_duplicates();
+    EXPECT_EQ(unique.shape(), (np::Shape{3, 2}));
+    EXPECT_EQ(unique["a"], (Series{np::Array<np::int_>{1, 2, 1}, "a"}));
+    EXPECT_EQ(unique["b"], (Series{np::Array<np::string_>{"x", "y", "y"}, "b"}));
+
+    auto diabetes = read_csv(getTestFile("diabetes.csv").string());
+    EXPECT_EQ(diabetes.drop_duplicates().shape(), diabetes.shape());
+}
+
+TEST_F(DataFrameTest, corrTest) {
+    DataFrame df;
+    df.append(Series{np::Array<np::float_>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, "x"});
+    df.append(Series{np::Array<np::int_>{3, 5, 7, 9, 11, 13}, "y"});
+    df.append(Series{np::Array<np::float_>{1.0, 8.0, 27.0, 64.0, 125.0, 216.0}, "cube"});
+    df.append(Series{np::Array<np::string_>{"a", "b", "c", "d", "e", "f"}, "name"});
+    df.append(Series{np::Array<np::float_>{6.0, 5.0, 4.0, 3.0, 2.0, 1.0}, "reverse"});
+
+    auto cov = df.cov();
+    EXPECT_EQ(cov.shape(), (np::Shape{4, 4}));
+    EXPECT_NEAR(static_cast<np::float_>(cov.at(0, "x")), 3.5, 1e-12);
+    EXPECT_NEAR(static_cast<np::float_>(cov.at(1, "x")), 7.0, 1e-12);
+    EXPECT_NEAR(static_cast<np::float_>(cov.at(3, "x")), -3.5, 1e-12);
+
+    auto pearson = df.corr();
+    EXPECT_NEAR(static_cast<np::float_>(pearson.at(0, "y")), 1.0, 1e-12);
+    EXPECT_NEAR(static_cast<np::float_>(pearson.at(0, "reverse")), -1.0, 1e-12);
+    EXPECT_LT(static_cast<np::float_>(pearson.at(0, "cube")), 0.95);
+    auto spearman = df.corr(CorrelationMethod::kSpearman);
+    EXPECT_NEAR(static_cast<np::float_>(spearman.at(0, "cube")), 1.0, 1e-12);
+    EXPECT_NEAR(static_cast<np::float_>(spearman.at(2, "reverse")), -1.0, 1e-12);
+
+    // Rows with NaN are left out pair by pair
+    df.append(Series{np::Array<np::float_>{2.0, np::NaN, 6.0, 8.0, np::NaN, 12.0}, "gaps"});
+    auto withGaps = df.corr();
+    EXPECT_NEAR(static_cast<np::float_>(withGaps.at(0, "gaps")), 1.0, 1e-12);
+    EXPECT_NEAR(static_cast<np::float_>(withGaps.at(0, "reverse")), -1.0, 1e-12);
+    EXPECT_NEAR(static_cast<np::float_>(df.cov().at(0, "gaps")), 26.0 / 3.0, 1e-12);
+    EXPECT_NEAR(static_cast<np::float_>(df.corr(CorrelationMethod::kSpearman).at(2, "gaps")), 1.0, 1e-12);
+}
+
+TEST_F(DataFrameTest, corrLargeTest) {
+    auto df = pd::read_csv(getTestFile("diabetes.csv").string());
+    auto corr = df.corr();
+    auto columns = df.columns().getIndex();
+    EXPECT_EQ(corr.shape(), (np::Shape{columns.size(), columns.size()}));
+    for (np::Size i = 0; i < columns.size(); ++i) {
+        EXPECT_NEAR(static_cast<np::float_>(corr.at(i, columns[i])), 1.0, 1e-12);
+        for (np::Size j = 0; j < columns.size(); ++j) {
+            EXPECT_NEAR(static_cast<np::float_>(corr.at(i, columns[j])), static_cast<np::float_>(corr.at(j, columns[i])), 1e-12);
+        }
+    }
+    // Same as the correlation of the two series computed directly
+    const auto &glucose = df["Glucose"];
+    const auto &outcome = df["Outcome"];
+    np::float_ meanX = glucose.mean();
+    np::float_ meanY = outcome.mean();
+    np::float_ sxy = 0;
+    np::float_ sxx = 0;
+    np::float_ syy = 0;
+    for (np::Size i = 0; i < glucose.size(); ++i) {
+        auto dx = static_cast<np::float_>(static_cast<np::int_>(glucose.at(i))) - meanX;
+        auto dy = static_cast<np::float_>(static_cast<np::int_>(outcome.at(i))) - meanY;
+        sxy += dx * dy;
+        sxx += dx * dx;
+        syy += dy * dy;
+    }
+    EXPECT_NEAR(static_cast<np::float_>(corr.at(1, "Outcome")), sxy / std::sqrt(sxx * syy), 1e-12);
+}
+
+TEST_F(DataFrameTest, matmulTest) {
+    DataFrame features;
+    features.append(Series{np::Array<np::float_>{1.0, 0.0, 2.0}, "a"});
+    features.append(Series{np::Array<np::int_>{2, 1, -1}, "b"});
+    DataFrame weights;
+    weights.append(Series{np::Array<np::float_>{0.5, 1.0}, "score"});
+    weights.append(Series{np::Array<np::float_>{1.0, -1.0}, "margin"});
+
+    auto result = features.matmul(weights);
+    EXPECT_EQ(result.shape(), (np::Shape{3, 2}));
+    DataFrame expected;
+    expected.append(Series{np::Array<np::float_>{2.5, 1.0, 0.0}, "score"});
+    expected.append(Series{np::Array<np::float_>{-1.0, -1.0, 3.0}, "margin"});
+    EXPECT_EQ(result, expected);
+    EXPECT_THROW(features.matmul(features), std::runtime_error);
+
+    // Rows of the product keep the labels of the left frame
+    np::float_ labelled[3][2] = {{1.0, 2.0}, {0.0, 1.0}, {2.0, -1.0}};
+    std::vector<internal::Value> labels{"x", "y", "z"};
+    DataFrame labelledFeatures{np::Array<np::float_>{labelled}, DataFrameParameters{labels, {"a", "b"}}};
+    EXPECT_EQ(labelledFeatures.matmul(weights).index().getIndex(), labels);
+
+    // Larger than a row block and a register tile, against the scalar definition
+    const np::Size rows = 1000;
+    const np::Size inner = 7;
+    const np::Size columns = 5;
+    DataFrame left;
+    for (np::Size p = 0; p < inner; ++p) {
+        np::Array<np::float_> column{np::Shape{rows}};
+        for (np::Size i = 0; i < rows; ++i) {
+            column.set(i, static_cast<np::float_>((i * 31 + p * 17) % 23) - 11.0);
+        }
+        left.append(Series{column, static_cast<np::int_>(p)});
+    }
+    DataFrame right;
+    for (np::Size j = 0; j < columns; ++j) {
+        np::Array<np::float_> column{np::Shape{inner}};
+        for (np::Size p = 0; p < inner; ++p) {
+            column.set(p, static_cast<np::float_>(p) * 0.25 - static_cast<np::float_>(j));
+        }
+        right.append(Series{column, static_cast<np::int_>(j)});
+    }
+    auto product = left.matmul(right);
+    for (np::Size i = 0; i < rows; i += 97) {
+        for (np::Size j = 0; j < columns; ++j) {
+            np::float_ sum = 0.0;
+            for (np::Size p = 0; p < inner; ++p) {
+                sum += static_cast<np::float_>(left.iloc(i, p)) * static_cast<np::float_>(right.iloc(p, j));
+            }
+            EXPECT_DOUBLE_EQ(static_cast<np::float_>(product.iloc(i, j)), sum);
+        }
+    }
+}
+
+TEST_F(DataFrameTest, appendMoveTest) {
+    np::Array<np::string_> names{"a", "b", "c"};
+    Series series{std::move(names), "name"};
+    EXPECT_EQ(series, (Series{np::Array<np::string_>{"a", "b", "c"}, "name"}));
+
+    DataFrame df;
+    df.append(std::move(series));
+    df.append(Series{np::Array<np::int_>{1, 2, 3}, "value"});
+    DataFrame other;
+    other.append(Series{np::Array<np::float_>{0.5, 1.5, 2.5}, "weight"});
+    df.append(std::move(other));
+    EXPECT_EQ(df.shape(), (np::Shape{3, 3}));
+    EXPECT_EQ(df["name"], (Series{np::Array<np::string_>{"a", "b", "c"}, "name"}));
+    EXPECT_EQ(df["weight"], (Series{np::Array<np::float_>{0.5, 1.5, 2.5}, "weight"}));
+}
+
+TEST_F(DataFrameTest, itertuplesTest) {
+    auto df = pd::read_csv(getTestFile("diabetes.csv").string());
+    auto rows = df.itertuples();
+    EXPECT_EQ(rows.size(), 768);
+    auto glucose = rows.column("Glucose");
+    auto bmi = rows.column("BMI");
+    np::int_ glucoseSum = 0;
+    np::float_ bmiSum = 0.0;
+    np::Size count = 0;
+    for (const auto &row: rows) {
+        glucoseSum += row.get<np::int_>(glucose);
+        bmiSum += row.number(bmi);
+        ++count;
+    }
+    EXPECT_EQ(count, 768);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(glucoseSum), df["Glucose"].mean() * 768);
+    EXPECT_NEAR(bmiSum, df["BMI"].mean() * 768, 1e-9);
+    EXPECT_EQ((*rows.begin())[glucose], internal::Value{np::int_{148}});
+    EXPECT_THROW(static_cast<void>((*rows.begin()).get<np::float_>(glucose)), std::runtime_error);
+
+    auto batches = df.batches(100);
+    auto age = batches.column("Age");
+    np::Size total = 0;
+    np::float_ ageSum = 0.0;
+    while (batches.next()) {
+        EXPECT_EQ(batches.begin(), total);
+        for (np::Size i = 0; i < batches.rows(); ++i) {
+            ageSum += batches.row(i)[age];
+        }
+        total += batches.rows();
+    }
+    EXPECT_EQ(total, 768);
+    EXPECT_FALSE(batches.next());
+    EXPECT_NEAR(ageSum, df["Age"].mean() * 768, 1e-9);
+}
+
+TEST_F(DataFrameTest, numpyRoundTripTest) {
+    const np::Size rows = 300;
+    const np::Size columns = 70;
+    np::Array<np::float_> matrix{np::Shape{rows, columns}};
+    for (np::Size i = 0; i < rows * columns; ++i) {
+        matrix.set(i, static_cast<np::float_>(i) * 0.5);
+    }
+    DataFrame df{matrix};
+    EXPECT_EQ(df.shape(), (np::Shape{rows, columns}));
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(df.iloc(123, 45)), static_cast<np::float_>(123 * columns + 45) * 0.5);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(df.iloc(rows - 1, columns - 1)), static_cast<np::float_>(rows * columns - 1) * 0.5);
+
+    auto array = df.to_numpy();
+    EXPECT_EQ(array.shape(), matrix.shape());
+    for (np::Size i = 0; i < rows * columns; ++i) {
+        ASSERT_DOUBLE_EQ(array.get(i), matrix.get(i));
+    }
+
+    auto diabetes = pd::read_csv(getTestFile("diabetes.csv").string());
+    auto values = diabetes.to_numpy();
+    EXPECT_EQ(values.shape(), (np::Shape{768, 9}));
+    EXPECT_DOUBLE_EQ(values.get(6), 0.627);
+    EXPECT_DOUBLE_EQ(values.get(5 * 9 + 5), 25.6);
+}
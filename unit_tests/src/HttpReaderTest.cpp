@@ -0,0 +1,333 @@
+/*
+⚡ Data manipulation and analysis library in C++ | CUDA GPU + (AVX2/AVX512/AMX) CPU
+
+Copyright (c) 2023-2026 Mikhail Gorshkov (mikhail.gorshkov@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <zlib.h>
+
+#include <pd/core/internal/httpreader/ConnectionPool.hpp>
+#include <pd/core/internal/httpreader/Connector.hpp>
+#include <pd/core/internal/httpreader/HttpHandler.hpp>
+#include <pd/core/internal/httpreader/HttpReader.hpp>
+#include <pd/core/internal/httpreader/Poll.hpp>
+#include <pd/core/internal/httpreader/RangeDownloader.hpp>
+#include <pd/core/internal/httpreader/ReadBufferPool.hpp>
+#include <pd/core/internal/httpreader/SslConnector.hpp>
+#include <pd/core/internal/httpreader/SslInitializer.hpp>
+#include <pd/core/internal/httpreader/SslStream.hpp>
+#include <pd/read_csv.hpp>
+
+#include <PdTest.hpp>
+#include <TestHttpServer.hpp>
+
+using namespace pd::internal::httpreader;
+
+class HttpReaderTest : public PdTest {
+protected:
+    // Returns a prepared response in pieces of the given size, then reports a closed connection
+    class FakeStream : public Stream {
+    public:
+        FakeStream(std::string response, std::size_t pieceSize)
+            : m_response{std::move(response)}, m_pieceSize{pieceSize} {
+        }
+
+        std::size_t read(void *buffer, std::size_t count) const override {
+            std::size_t size = std::min({count, m_pieceSize, m_response.size() - m_position});
+            std::copy_n(m_response.data() + m_position, size, static_cast<char *>(buffer));
+            m_position += size;
+            return size;
+        }
+
+    private:
+        std::string m_response;
+        std::size_t m_pieceSize;
+        mutable std::size_t m_position{0};
+    };
+
+    static std::string readBody(const std::string &response, std::size_t pieceSize, HttpMessage::Method method = HttpMessage::Method::kGet) {
+        std::string body;
+        HttpReader reader{[&body](const char *data, std::size_t size) {
+                              body.append(data, size);
+                          },
+                          [](const std::string &) {
+                          },
+                          method};
+        auto stream = std::make_shared<FakeStream>(response, pieceSize);
+        while (!reader.isReadComplete()) {
+            reader.read(stream);
+        }
+        return body;
+    }
+
+    static std::string gzip(const std::string &text) {
+        return compress(text, MAX_WBITS + 16);
+    }
+
+    // Window bits select the format as for zlib: gzip above MAX_WBITS, raw deflate when negative
+    static std::string compress(const std::string &text, int windowBits) {
+        z_stream stream{};
+        deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+        std::string compressed(deflateBound(&stream, text.size()), '\0');
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(text.data()));
+        stream.avail_in = static_cast<uInt>(text.size());
+        stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+        stream.avail_out = static_cast<uInt>(compressed.size());
+        deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+        return compressed;
+    }
+
+    static std::string chunked(const std::string &body, std::size_t chunkSize) {
+        std::string result;
+        for (std::size_t pos = 0; pos < body.size(); pos += chunkSize) {
+            auto chunk = body.substr(pos, chunkSize);
+            char size[32];
+            std::snprintf(size, sizeof(size), "%zx;ext=1\r\n", chunk.size());
+            result += size + chunk + "\r\n";
+        }
+        return result + "0\r\nExpires: never\r\n\r\n";
+    }
+
+    static std::string makeCsv(std::size_t rows) {
+        std::string csv = "a,b\n";
+        for (std::size_t i = 0; i < rows; ++i) {
+            csv += std::to_string(i) + "," + std::to_string(i * 3) + "\n";
+        }
+        return csv;
+    }
+};
+
+TEST_F(HttpReaderTest, contentLength) {
+    std::string body = makeCsv(1000);
+    std::string response = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body + "garbage";
+    EXPECT_EQ(readBody(response, 333), body);
+}
+
+TEST_F(HttpReaderTest, chunked) {
+    std::string body = makeCsv(1000);
+    std::string response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n" + chunked(body, 1000);
+    EXPECT_EQ(readBody(response, 7), body);
+    EXPECT_EQ(readBody(response, 64 * 1024), body);
+}
+
+TEST_F(HttpReaderTest, chunkedGzip) {
+    std::string body = makeCsv(100000);
+    std::string compressed = gzip(body);
+    std::string response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nContent-Encoding: gzip\r\n\r\n" + chunked(compressed, 4096);
+    EXPECT_EQ(readBody(response, 1500), body);
+}
+
+TEST_F(HttpReaderTest, gzipMemberPerChunk) {
+    std::string body = makeCsv(1000);
+    std::string response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nContent-Encoding: gzip\r\n\r\n";
+    // Each chunk is a gzip member of its own, so a member ends with every piece the inflater gets
+    for (std::size_t pos = 0; pos < body.size(); pos += 1000) {
+        std::string member = gzip(body.substr(pos, 1000));
+        char size[32];
+        std::snprintf(size, sizeof(size), "%zx\r\n", member.size());
+        response += size + member + "\r\n";
+    }
+    response += "0\r\n\r\n";
+    EXPECT_EQ(readBody(response, 64 * 1024), body);
+    EXPECT_EQ(readBody(response, 7), body);
+}
+
+TEST_F(HttpReaderTest, deflate) {
+    std::string body = makeCsv(1000);
+    for (int windowBits: {MAX_WBITS, -MAX_WBITS}) {
+        std::string compressed = compress(body, windowBits);
+        std::string response = "HTTP/1.1 200 OK\r\nContent-Encoding: deflate\r\nContent-Length: " + std::to_string(compressed.size()) + "\r\n\r\n" + compressed;
+        EXPECT_EQ(readBody(response, 64 * 1024), body);
+        // A raw body is only recognized at the second byte, after the first one was taken
+        EXPECT_EQ(readBody(response, 1), body);
+    }
+}
+
+TEST_F(HttpReaderTest, truncatedChunked) {
+    std::string body = makeCsv(100);
+    std::string response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n" + chunked(body, 100);
+    response.resize(response.size() - 10);
+    EXPECT_THROW(readBody(response, 100), std::runtime_error);
+}
+
+TEST_F(HttpReaderTest, headResponse) {
+    // The header describes the body a GET would get, none follows
+    std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 1000\r\nTransfer-Encoding: chunked\r\nContent-Encoding: gzip\r\n\r\n";
+    EXPECT_EQ(readBody(response, 7, HttpMessage::Method::kHead), "");
+}
+
+TEST_F(HttpReaderTest, notModifiedResponse) {
+    std::string response = "HTTP/1.1 304 Not Modified\r\nContent-Length: 1000\r\nContent-Encoding: gzip\r\nETag: \"v1\"\r\n\r\n";
+    EXPECT_EQ(readBody(response, 1000), "");
+}
+
+TEST_F(HttpReaderTest, headerByteByByte) {
+    std::string body = makeCsv(100);
+    std::string response = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length:  " + std::to_string(body.size()) +
+                           " \r\nConnection: close\r\nLocation: /elsewhere\r\n\r\n" + body;
+    std::string received;
+    HttpReader reader{[&received](const char *data, std::size_t size) {
+                          received.append(data, size);
+                      },
+                      [](const std::string &) {
+                      }};
+    auto stream = std::make_shared<FakeStream>(response, 1);
+    while (reader.response() == nullptr) {
+        reader.read(stream);
+    }
+    const auto *message = reader.response();
+    EXPECT_EQ(message->m_statusCode, HttpMessage::StatusCodes::kOk);
+    EXPECT_EQ(message->m_contentLength, body.size());
+    EXPECT_TRUE(message->m_connectionClose);
+    EXPECT_EQ(message->m_location, "/elsewhere");
+    EXPECT_EQ(message->m_headerSize, response.size() - body.size());
+    EXPECT_TRUE(received.empty());
+    while (!reader.isReadComplete()) {
+        reader.read(stream);
+    }
+    EXPECT_EQ(received, body);
+}
+
+TEST_F(HttpReaderTest, tooBigHeader) {
+    std::string response = "HTTP/1.1 200 OK\r\nX-Padding: " + std::string(HttpHeaderParser::kMaxHttpHeaderSize, 'x') + "\r\n\r\n";
+    EXPECT_THROW(readBody(response, 4096), std::runtime_error);
+}
+
+// The local test server is POSIX only
+#ifndef _WIN32
+TEST_F(HttpReaderTest, manyConnectionsOnOneLoop) {
+    std::string body = makeCsv(1000);
+    TestHttpServer server{body};
+    const std::size_t connections = 200;
+    std::vector<std::string> bodies(connections);
+    Poll poll;
+    for (std::size_t i = 0; i < connections; ++i) {
+        poll.addHandler(std::make_shared<HttpHandler>(
+                "pd",
+                parseUri(server.url()),
+                [&bodies, i](const char *data, std::size_t size) {
+                    bodies[i].append(data, size);
+                },
+                [](const std::string &) {
+                }));
+    }
+    EXPECT_EQ(poll.size(), connections);
+    poll.run();
+    EXPECT_EQ(poll.size(), 0);
+    for (const auto &received: bodies) {
+        EXPECT_EQ(received, body);
+    }
+}
+
+TEST_F(HttpReaderTest, rangesOfChangedFile) {
+    std::string body = makeCsv(1000);
+    TestHttpServer server{body};
+    server.setBody(body, "\"v2\"");
+    auto download = [&server, &body](const std::string &etag) {
+        std::string received;
+        RangeDownloader<HttpHandler> downloader{parseUri(server.url()), 100, body.size(), 3, 1000, CacheValidators{etag, ""}};
+        downloader.run([&received](const char *data, std::size_t size) {
+            received.append(data, size);
+        });
+        return received;
+    };
+    EXPECT_EQ(download("\"v2\""), body.substr(100));
+    // The server has another version than the first range came from
+    EXPECT_THROW(download("\"v1\""), std::runtime_error);
+}
+
+#endif
+
+TEST_F(HttpReaderTest, readBufferPool) {
+    auto &pool = ReadBufferPool::instance();
+    const char *data = nullptr;
+    {
+        auto slab = pool.acquire();
+        EXPECT_EQ(slab.size(), ReadBufferPool::kSlabSize);
+        data = slab.data();
+    }
+    // A released slab is handed out again
+    auto slab = pool.acquire();
+    EXPECT_EQ(slab.data(), data);
+}
+
+#if defined(OPENSSL) && !defined(_WIN32)
+TEST_F(HttpReaderTest, tlsReadsWholeRecords) {
+    std::string body = makeCsv(20000);
+    TestHttpServer server{body, true, TestHttpServer::Transport::kTls};
+    SslInitializer initializer;
+    auto uri = parseUri(server.url());
+    auto stream = std::make_shared<SslStream>();
+    connect(stream, uri.m_address);
+    sslConnect(stream, uri.m_address);
+    std::string request = "GET /data.csv HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    EXPECT_EQ(stream->write(request.data(), request.size()), request.size());
+    // The whole response is sent as full records: let them all arrive
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+
+    std::string received;
+    std::vector<char> buffer(ReadBufferPool::kSlabSize);
+    // Room for one record and a part of the next one takes only the first
+    auto size = stream->read(buffer.data(), SSL3_RT_MAX_PLAIN_LENGTH + 1000);
+    EXPECT_EQ(size, SSL3_RT_MAX_PLAIN_LENGTH);
+    received.append(buffer.data(), size);
+    // A slab takes all ready records in one call
+    size = stream->read(buffer.data(), buffer.size());
+    EXPECT_GT(size, SSL3_RT_MAX_PLAIN_LENGTH);
+    received.append(buffer.data(), size);
+    auto headerEnd = received.find("\r\n\r\n");
+    ASSERT_NE(headerEnd, std::string::npos);
+    while (received.size() < headerEnd + 4 + body.size()) {
+        size = stream->read(buffer.data(), buffer.size());
+        ASSERT_GT(size, 0);
+        received.append(buffer.data(), size);
+    }
+    EXPECT_EQ(received.substr(headerEnd + 4), body);
+}
+
+TEST_F(HttpReaderTest, tlsSessionResumption) {
+    TestHttpServer server{makeCsv(1000), true, TestHttpServer::Transport::kTls};
+    auto df = pd::read_csv(server.url());
+    EXPECT_EQ(df.shape(), (np::Shape{1000, 2}));
+    // A new connection to the same server resumes the session of the first one
+    ConnectionPool::instance().clear();
+    df = pd::read_csv(server.url());
+    EXPECT_EQ(df.shape(), (np::Shape{1000, 2}));
+    EXPECT_EQ(server.connections(), 2);
+    EXPECT_EQ(server.resumedSessions(), 1);
+}
+#endif
+
+#ifdef OPENSSL
+TEST_F(HttpReaderTest, tlsReadStatisticsRemote) {
+    SslStream::resetReadStatistics();
+    auto df = pd::read_csv("https://raw.githubusercontent.com/plotly/datasets/master/diabetes.csv");
+    auto statistics = SslStream::readStatistics();
+    EXPECT_GT(statistics.bytes, 0);
+    EXPECT_GT(statistics.calls, 0);
+    EXPECT_GT(statistics.throughput(), 0.0);
+}
+#endif
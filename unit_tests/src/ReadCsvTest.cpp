@@ -22,9 +22,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
 #include <pd/read_csv.hpp>
 
 #include <PdTest.hpp>
+#include <TestHttpServer.hpp>
 
 using namespace pd;
 
@@ -99,3 +105,202 @@ TEST_F(ReadCsvTest, readFromRemoteFile) {
     internal::Value columnNames[] = {"Pregnancies", "Glucose", "BloodPressure", "SkinThickness", "Insulin", "BMI", "DiabetesPedigreeFunction", "Age", "Outcome"};
     checkDataFrame(df, columnNames);
 }
+
+TEST_F(ReadCsvTest, readLargeFileInChunks) {
+    // Spans several read chunks, so lines are split between them
+    const np::Size rows = 100000;
+    auto path = std::filesystem::temp_directory_path() / "pd_read_csv_chunks.csv";
+    {
+        std::ofstream stream{path};
+        stream << "Id,Value,Name,Missing\r\n";
+        for (np::Size i = 0; i < rows; ++i) {
+            stream << i << ',';
+            if (i == rows - 1) {
+                stream << "0.5";
+            } else {
+                stream << i * 2;
+            }
+            stream << ",name" << i << ',';
+            if (i % 2 == 0) {
+                stream << i;
+            }
+            stream << "\r\n";
+        }
+    }
+    auto df = read_csv(path.string());
+    std::filesystem::remove(path);
+
+    np::Shape shape{rows, 4};
+    EXPECT_EQ(df.shape(), shape);
+    EXPECT_EQ(df["Id"].dtype(), "int64");
+    EXPECT_EQ(df["Value"].dtype(), "float64");
+    EXPECT_EQ(df["Missing"].dtype(), "float64");
+    EXPECT_EQ(static_cast<np::int_>(df["Id"].iloc(rows - 1)), rows - 1);
+    EXPECT_EQ(static_cast<np::float_>(df["Value"].iloc(12345)), 24690.0);
+    EXPECT_EQ(static_cast<np::float_>(df["Value"].iloc(rows - 1)), 0.5);
+    EXPECT_EQ(static_cast<std::string>(df["Name"].iloc(54321)), "name54321");
+    EXPECT_EQ(static_cast<np::float_>(df["Missing"].iloc(4)), 4.0);
+    EXPECT_TRUE(std::isnan(static_cast<np::float_>(df["Missing"].iloc(5))));
+}
+
+// The local test server is POSIX only
+#ifndef _WIN32
+static std::string readTestFile(const std::filesystem::path &path) {
+    std::ifstream stream{path, std::ios::binary};
+    std::ostringstream content;
+    content << stream.rdbuf();
+    return content.str();
+}
+
+TEST_F(ReadCsvTest, readFromLocalServerInRanges) {
+    auto path = getTestFile("diabetes.csv");
+    TestHttpServer server{readTestFile(path)};
+    ReadCsvSettings settings;
+    settings.connections = 4;
+    settings.rangeSize = 1000;
+    auto df = read_csv(server.url(), settings);
+    compare(df, read_csv(path.string()));
+    // The whole file is requested and cut off after the first range, then more ranges than connections follow
+    EXPECT_GT(server.rangeRequests(), settings.connections);
+    EXPECT_EQ(server.requests(), server.rangeRequests() + 1);
+    // Connections of the ranges are kept alive between the rounds
+    EXPECT_LE(server.connections(), settings.connections + 1);
+}
+
+TEST_F(ReadCsvTest, readFromLocalServerGzip) {
+    auto path = getTestFile("diabetes.csv");
+    TestHttpServer server{readTestFile(path)};
+    server.setGzip(true);
+    ReadCsvSettings settings;
+    settings.rangeSize = 1000;
+    auto df = read_csv(server.url(), settings);
+    compare(df, read_csv(path.string()));
+    // A compressed file comes whole, even with ranges supported
+    EXPECT_EQ(server.gzipResponses(), 1);
+    EXPECT_EQ(server.rangeRequests(), 0);
+    EXPECT_EQ(server.requests(), 1);
+}
+
+TEST_F(ReadCsvTest, readFromLocalServerWithoutRanges) {
+    auto path = getTestFile("diabetes.csv");
+    TestHttpServer server{readTestFile(path), false};
+    ReadCsvSettings settings;
+    settings.rangeSize = 1000;
+    auto df = read_csv(server.url(), settings);
+    compare(df, read_csv(path.string()));
+    // The whole file comes over one connection
+    EXPECT_EQ(server.rangeRequests(), 0);
+    EXPECT_EQ(server.requests(), 1);
+}
+
+TEST_F(ReadCsvTest, reuseConnections) {
+    auto path = getTestFile("diabetes.csv");
+    TestHttpServer server{readTestFile(path)};
+    auto expected = read_csv(path.string());
+    for (int i = 0; i < 5; ++i) {
+        compare(read_csv(server.url()), expected);
+    }
+    // One request per call, all over one kept-alive connection
+    EXPECT_EQ(server.requests(), 5);
+    EXPECT_EQ(server.connections(), 1);
+}
+
+TEST_F(ReadCsvTest, retryDroppedConnection) {
+    auto path = getTestFile("diabetes.csv");
+    TestHttpServer server{readTestFile(path)};
+    auto expected = read_csv(path.string());
+    compare(read_csv(server.url()), expected);
+    // The kept-alive connection is closed on the next request, which is sent again over a new one
+    server.dropRequests(1);
+    compare(read_csv(server.url()), expected);
+    EXPECT_EQ(server.requests(), 3);
+    EXPECT_EQ(server.connections(), 2);
+}
+
+TEST_F(ReadCsvTest, timeout) {
+    TestHttpServer server{readTestFile(getTestFile("diabetes.csv"))};
+    server.setResponseDelay(std::chrono::milliseconds{1000});
+    ReadCsvSettings settings;
+    settings.timeout = std::chrono::milliseconds{100};
+    EXPECT_THROW(read_csv(server.url(), settings), std::runtime_error);
+}
+
+TEST_F(ReadCsvTest, readMany) {
+    auto path = getTestFile("diabetes.csv");
+    auto noHeaderPath = getTestFile("diabetes_noheader.csv");
+    TestHttpServer server{readTestFile(path)};
+    std::vector<std::string> paths{path.string(), server.url("/1.csv"), noHeaderPath.string(), server.url("/2.csv"), server.url("/3.csv")};
+    auto frames = read_csv_many(paths);
+    ASSERT_EQ(frames.size(), paths.size());
+    auto expected = read_csv(path.string());
+    compare(frames[0], expected);
+    compare(frames[1], expected);
+    compare(frames[2], read_csv(noHeaderPath.string()));
+    compare(frames[3], expected);
+    compare(frames[4], expected);
+    EXPECT_EQ(server.requests(), 3);
+
+    EXPECT_THROW(read_csv_many({server.url(), "missing.csv"}), std::runtime_error);
+}
+
+TEST_F(ReadCsvTest, cache) {
+    auto path = getTestFile("diabetes.csv");
+    auto noHeaderPath = getTestFile("diabetes_noheader.csv");
+    auto cacheDirectory = std::filesystem::temp_directory_path() / "pd_read_csv_cache";
+    std::filesystem::remove_all(cacheDirectory);
+    TestHttpServer server{readTestFile(path)};
+    server.setBody(readTestFile(path), "\"v1\"");
+    auto expected = read_csv(path.string());
+    ReadCsvSettings settings;
+    settings.cacheDirectory = cacheDirectory.string();
+    settings.rangeSize = 1000;
+    // Downloaded in ranges and stored, then revalidated by the request of the whole file
+    compare(read_csv(server.url(), settings), expected);
+    EXPECT_EQ(server.notModifiedResponses(), 0);
+    std::size_t requests = server.requests();
+    compare(read_csv(server.url(), settings), expected);
+    EXPECT_EQ(server.notModifiedResponses(), 1);
+    EXPECT_EQ(server.requests(), requests + 1);
+    // Revalidated without ranges as well
+    settings.connections = 1;
+    compare(read_csv(server.url(), settings), expected);
+    EXPECT_EQ(server.notModifiedResponses(), 2);
+    // A changed file is downloaded again and replaces the stored one
+    auto changed = read_csv(noHeaderPath.string());
+    server.setBody(readTestFile(noHeaderPath), "\"v2\"");
+    compare(read_csv(server.url(), settings), changed);
+    EXPECT_EQ(server.notModifiedResponses(), 2);
+    compare(read_csv(server.url(), settings), changed);
+    EXPECT_EQ(server.notModifiedResponses(), 3);
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+TEST_F(ReadCsvTest, readAsync) {
+    auto path = getTestFile("diabetes.csv");
+    TestHttpServer server{readTestFile(path)};
+    auto expected = read_csv(path.string());
+    auto local = read_csv_async(path.string());
+    auto remote = read_csv_async(server.url());
+    compare(local.get(), expected);
+    compare(remote.get(), expected);
+
+    // More than the pipeline buffer, so the reader waits for the parser
+    const np::Size rows = 500000;
+    std::string csv = "Id,Name\n";
+    for (np::Size i = 0; i < rows; ++i) {
+        csv += std::to_string(i) + ",name" + std::to_string(i) + "\n";
+    }
+    server.setBody(csv);
+    auto df = read_csv_async(server.url()).get();
+    np::Shape shape{rows, 2};
+    EXPECT_EQ(df.shape(), shape);
+    EXPECT_EQ(static_cast<std::string>(df["Name"].iloc(rows - 1)), "name" + std::to_string(rows - 1));
+
+    // A parse error stops the reader waiting for free space
+    server.setBody("Id,Name\n1,2,3\n" + csv);
+    EXPECT_THROW(read_csv_async(server.url()).get(), std::runtime_error);
+
+    auto missing = read_csv_async("missing.csv");
+    EXPECT_THROW(missing.get(), std::runtime_error);
+}
+#endif
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <cmath>
 #include <sstream>
 
 #include <np/Constants.hpp>
@@ -86,3 +87,294 @@ TEST_F(SeriesTest, replaceTest) {
     Series pregnanciesReplacedSample{np::Array<np::float_>{148.0, 85.0, 183.0, np::NaN, 137.0, 116.0, 78.0}, "Pregnancies"};
     EXPECT_EQ(pregnanciesReplacedResult, pregnanciesReplacedSample);
 }
+
+TEST_F(SeriesTest, momentsTest) {
+    Series glucose{np::Array<np::float_>{148.0, 85.0, np::NaN, 183.0, 89.0, 137.0, 116.0, 78.0}, "Glucose"};
+    EXPECT_DOUBLE_EQ(glucose.mean(), 119.42857142857143);
+    EXPECT_DOUBLE_EQ(glucose.var(), 1286.530612244898);
+    EXPECT_DOUBLE_EQ(glucose.std_(), std::sqrt(1286.530612244898));
+    EXPECT_TRUE(std::isnan(glucose.mean(false)));
+    EXPECT_TRUE(std::isnan(glucose.var(false)));
+
+    auto description = glucose.describe();
+    EXPECT_EQ(description.size(), 5);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(description.at(0)), 7.0);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(description.at(1)), 119.42857142857143);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(description.at(2)), std::sqrt(1286.530612244898));
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(description.at(3)), 78.0);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(description.at(4)), 183.0);
+
+    // Spans many blocks: partial moments are merged
+    static const constexpr np::Size kSize = 7 * 42858;
+    np::Array<np::int_> large{np::Shape{kSize}};
+    for (np::Size i = 0; i < kSize; ++i) {
+        large.set(i, static_cast<np::int_>(1000000000 + i % 7));
+    }
+    Series series{large};
+    EXPECT_NEAR(series.mean(), 1000000000.0 + 3.0, 1e-6);
+    EXPECT_NEAR(series.var(), 4.0, 1e-6);
+
+    Series empty{np::Array<internal::Value>{np::Shape{0}}};
+    EXPECT_EQ(empty.mean(), 0.0);
+}
+
+TEST_F(SeriesTest, quantileTest) {
+    Series glucose{np::Array<np::float_>{148.0, 85.0, np::NaN, 183.0, 89.0, 137.0, 116.0, 78.0}, "Glucose"};
+    EXPECT_DOUBLE_EQ(glucose.median(), 116.0);
+    EXPECT_DOUBLE_EQ(glucose.quantile(0.25), 87.0);
+    EXPECT_DOUBLE_EQ(glucose.quantile(1.0), 183.0);
+    auto quantiles = glucose.quantile({0.0, 0.5, 0.9});
+    EXPECT_EQ(quantiles.size(), 3);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(quantiles.at(0)), 78.0);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(quantiles.at(1)), 116.0);
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(quantiles.at(2)), 162.0);
+    EXPECT_THROW(static_cast<void>(glucose.quantile(1.5)), std::runtime_error);
+
+    static const constexpr np::Size kSize = 100000;
+    np::Array<np::int_> part1{np::Shape{kSize}};
+    np::Array<np::int_> part2{np::Shape{kSize}};
+    for (np::Size i = 0; i < kSize; ++i) {
+        part1.set(i, static_cast<np::int_>((i * 7919) % kSize));
+        part2.set(i, static_cast<np::int_>(kSize + (i * 104729) % kSize));
+    }
+    Series series1{part1};
+    Series series2{part2};
+    EXPECT_NEAR(series1.quantile(0.99, QuantileMethod::kApproximate), 98999.01, kSize * 0.001);
+    EXPECT_NEAR(series1.median(QuantileMethod::kApproximate), series1.median(), kSize * 0.005);
+
+    // Digests of separate chunks are merged
+    auto digest = series1.tdigest();
+    digest.merge(series2.tdigest());
+    EXPECT_DOUBLE_EQ(digest.count(), 2.0 * kSize);
+    EXPECT_NEAR(digest.quantile(0.5), kSize, 2 * kSize * 0.005);
+    EXPECT_NEAR(digest.quantile(0.999), 0.999 * (2 * kSize - 1), 2 * kSize * 0.0005);
+}
+
+TEST_F(SeriesTest, rollingTest) {
+    Series series{np::Array<np::float_>{1.0, 3.0, 2.0, np::NaN, 5.0, 4.0, 0.0}, "value"};
+    auto check = [](const Series &result, const std::vector<np::float_> &expected) {
+        ASSERT_EQ(result.size(), expected.size());
+        for (np::Size i = 0; i < result.size(); ++i) {
+            auto value = static_cast<np::float_>(result.at(i));
+            if (std::isnan(expected[i])) {
+                EXPECT_TRUE(std::isnan(value)) << i;
+            } else {
+                EXPECT_NEAR(value, expected[i], 1e-12) << i;
+            }
+        }
+    };
+    check(series.rolling(2).sum(), {np::NaN, 4.0, 5.0, np::NaN, np::NaN, 9.0, 4.0});
+    check(series.rolling(3, 1).mean(), {1.0, 2.0, 2.0, 2.5, 3.5, 4.5, 3.0});
+    check(series.rolling(3, 2).var(), {np::NaN, 2.0, 1.0, 0.5, 4.5, 0.5, 7.0});
+    check(series.rolling(3, 1).min(), {1.0, 1.0, 1.0, 2.0, 2.0, 4.0, 0.0});
+    check(series.rolling(3, 1).max(), {1.0, 3.0, 3.0, 3.0, 5.0, 5.0, 5.0});
+    check(series.expanding().sum(), {1.0, 4.0, 6.0, 6.0, 11.0, 15.0, 15.0});
+    check(series.expanding().max(), {1.0, 3.0, 3.0, 3.0, 5.0, 5.0, 5.0});
+    check(series.expanding(2).min(), {np::NaN, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0});
+
+    // Created on a temporary and kept with its labels
+    std::vector<internal::Value> labels{"a", "b", "c"};
+    auto rolling = Series{np::Array<np::float_>{1.0, 2.0, 3.0}, labels, "value"}.rolling(2);
+    auto sums = rolling.sum();
+    check(sums, {np::NaN, 3.0, 5.0});
+    EXPECT_EQ(sums.index().getIndex(), labels);
+    auto expanding = Series{np::Array<np::float_>{1.0, 2.0, 3.0}, labels, "value"}.expanding();
+    EXPECT_EQ(expanding.max().index().getIndex(), labels);
+}
+
+TEST_F(SeriesTest, scanTest) {
+    Series prices{np::Array<np::float_>{2.0, 1.0, np::NaN, 4.0, 3.0}, "price"};
+    EXPECT_EQ(prices.cumsum(), (Series{np::Array<np::float_>{2.0, 3.0, np::NaN, 7.0, 10.0}, "price"}));
+    EXPECT_EQ(prices.cumprod(), (Series{np::Array<np::float_>{2.0, 2.0, np::NaN, 8.0, 24.0}, "price"}));
+    EXPECT_EQ(prices.cummin(), (Series{np::Array<np::float_>{2.0, 1.0, np::NaN, 1.0, 1.0}, "price"}));
+    EXPECT_EQ(prices.cummax(), (Series{np::Array<np::float_>{2.0, 2.0, np::NaN, 4.0, 4.0}, "price"}));
+    EXPECT_EQ(prices.diff(), (Series{np::Array<np::float_>{np::NaN, -1.0, np::NaN, np::NaN, -1.0}, "price"}));
+    EXPECT_EQ(prices.shift(-2), (Series{np::Array<np::float_>{np::NaN, 4.0, 3.0, np::NaN, np::NaN}, "price"}));
+
+    Series counts{np::Array<np::intc>{1, 2, 3}, "count"};
+    EXPECT_EQ(counts.cumsum(), (Series{np::Array<np::int_>{1, 3, 6}, "count"}));
+    EXPECT_EQ(counts.cummax().dtype(), "int32");
+
+    std::vector<internal::Value> labels{"a", "b", "c"};
+    Series labelled{np::Array<np::intc>{1, 2, 3}, labels, "count"};
+    EXPECT_EQ(labelled.cumsum().index().getIndex(), labels);
+    EXPECT_EQ(labelled.diff().index().getIndex(), labels);
+    EXPECT_EQ(labelled.shift().index().getIndex(), labels);
+
+    // Large enough for the chunked scan
+    static const constexpr np::Size kSize = 300000;
+    np::Array<np::int_> ones{np::Shape{kSize}};
+    for (np::Size i = 0; i < kSize; ++i) {
+        ones.set(i, 1);
+    }
+    auto sums = Series{ones}.cumsum();
+    for (np::Size i = 0; i < kSize; i += 9973) {
+        EXPECT_EQ(static_cast<np::int_>(sums.at(i)), static_cast<np::int_>(i + 1));
+    }
+}
+
+TEST_F(SeriesTest, valueCountsTest) {
+    Series outcome{np::Array<np::int_>{1, 0, 1, 0, 1, 2}, "Outcome"};
+    auto counts = outcome.value_counts();
+    EXPECT_EQ(counts, (Series{np::Array<np::int_>{3, 2, 1}, std::vector<internal::Value>{np::int_{1}, np::int_{0}, np::int_{2}}, "Outcome"}));
+    EXPECT_EQ(outcome.unique(), (Series{np::Array<np::int_>{1, 0, 2}, "Outcome"}));
+    EXPECT_EQ(outcome.nunique(), 3);
+
+    Series names{np::Array<np::string_>{"b", "a", "b", "c", "a", "b"}, "name"};
+    auto nameCounts = names.value_counts();
+    EXPECT_EQ(nameCounts.index().getIndex(), (std::vector<internal::Value>{"b", "a", "c"}));
+    EXPECT_EQ(nameCounts.at(0), internal::Value{np::int_{3}});
+
+    Series values{np::Array<np::float_>{1.5, np::NaN, -0.0, 0.0, np::NaN}, "value"};
+    EXPECT_EQ(values.nunique(), 2);
+    EXPECT_EQ(values.nunique(false), 3);
+    EXPECT_EQ(values.value_counts(false).size(), 3);
+}
+
+TEST_F(SeriesTest, sketchTest) {
+    static const constexpr np::Size kSize = 200000;
+    np::Array<np::int_> part1{np::Shape{kSize}};
+    np::Array<np::int_> part2{np::Shape{kSize}};
+    for (np::Size i = 0; i < kSize; ++i) {
+        // 37500 distinct values in each part, 18750 of them shared; 7 is a heavy hitter
+        part1.set(i, i % 4 == 0 ? 7 : static_cast<np::int_>(i % 50000));
+        part2.set(i, i % 4 == 0 ? 7 : static_cast<np::int_>(25000 + i % 50000));
+    }
+    Series series1{part1, "id"};
+    Series series2{part2, "id"};
+    EXPECT_NEAR(static_cast<np::float_>(series1.approx_nunique()), static_cast<np::float_>(series1.nunique()), 0.03 * 37500);
+
+    auto hyperLogLog = series1.hyperloglog();
+    hyperLogLog.merge(series2.hyperloglog());
+    EXPECT_NEAR(hyperLogLog.estimate(), 56250.0, 0.03 * 56250);
+
+    auto top = series1.approx_top_k(1);
+    EXPECT_EQ(top.size(), 1);
+    EXPECT_EQ(top.index()[0], internal::Value{np::int_{7}});
+    EXPECT_GE(static_cast<np::int_>(top.at(0)), static_cast<np::int_>(kSize / 4));
+
+    auto spaceSaving = series1.space_saving(100);
+    spaceSaving.merge(series2.space_saving(100));
+    auto merged = spaceSaving.top(1);
+    EXPECT_EQ(merged[0].key, internal::Value{np::int_{7}});
+    EXPECT_GE(merged[0].count, kSize / 2);
+
+    auto evicted = Series{np::Array<np::int_>{1, 1, 2, 3}, "id"}.space_saving(2).top(2);
+    auto third = std::find_if(evicted.begin(), evicted.end(), [](const auto &counter) { return counter.key == internal::Value{np::int_{3}}; });
+    ASSERT_NE(third, evicted.end());
+    EXPECT_EQ(third->count, 2);
+    EXPECT_EQ(third->error, 1);
+
+    Series names{np::Array<np::string_>{"b", "a", "b", "c", "a", "b"}, "name"};
+    EXPECT_EQ(names.approx_nunique(), 3);
+    EXPECT_EQ(names.approx_top_k(2).index().getIndex(), (std::vector<internal::Value>{"b", "a"}));
+}
+
+TEST_F(SeriesTest, bulkReplaceTest) {
+    Series glucose{np::Array<np::int_>{148, 0, 183, 0, 137, -1}, "Glucose"};
+    auto replaced = glucose.replace({{0, np::NaN}, {-1, np::NaN}});
+    EXPECT_EQ(replaced, (Series{np::Array<np::float_>{148.0, np::NaN, 183.0, np::NaN, 137.0, np::NaN}, "Glucose"}));
+    EXPECT_EQ(glucose.replace({{0, 1}, {137, 2}}), (Series{np::Array<np::int_>{148, 1, 183, 1, 2, -1}, "Glucose"}));
+
+    std::unordered_map<internal::Value, internal::Value> many;
+    for (np::int_ i = 0; i < 200; ++i) {
+        many.emplace(i * 3, i);
+    }
+    np::Array<np::int_> large{np::Shape{1000}};
+    for (np::Size i = 0; i < 1000; ++i) {
+        large.set(i, static_cast<np::int_>(i));
+    }
+    auto replacedLarge = Series{large}.replace(many);
+    EXPECT_EQ(replacedLarge.at(300), internal::Value{np::int_{100}});
+    EXPECT_EQ(replacedLarge.at(301), internal::Value{np::int_{301}});
+    EXPECT_EQ(replacedLarge.at(600), internal::Value{np::int_{600}});
+
+    // Values that do not fit the dtype widen it instead of wrapping
+    Series flags{np::Array<np::bool_>{true, false}};
+    EXPECT_EQ(flags.replace({{true, 5}}), (Series{np::Array<np::int_>{5, 0}}));
+    Series small{np::Array<np::intc>{1, 2}};
+    EXPECT_EQ(small.replace({{1, np::int_{3000000000}}}), (Series{np::Array<np::int_>{3000000000, 2}}));
+    Series wide{np::Array<np::int_>{1, 2}};
+    auto huge = std::numeric_limits<np::Size>::max();
+    EXPECT_EQ(wide.replace({{1, huge}}), (Series{np::Array<np::float_>{static_cast<np::float_>(huge), 2.0}}));
+    EXPECT_EQ(wide.map({{1, huge}, {2, 0}}), (Series{np::Array<np::float_>{static_cast<np::float_>(huge), 0.0}}));
+
+    // Of keys matching alike the narrower type wins, whatever the hash map order
+    EXPECT_EQ(wide.replace({{1.0, 7}, {1, 8}}), (Series{np::Array<np::int_>{8, 2}}));
+
+    Series names{np::Array<np::string_>{"male", "female", "m", "f", "female"}, "sex"};
+    auto mapped = names.map({{"male", "M"}, {"m", "M"}, {"female", "F"}, {"f", "F"}});
+    EXPECT_EQ(mapped, (Series{np::Array<np::string_>{"M", "F", "M", "F", "F"}, "sex"}));
+    auto codes = names.map({{"male", 0}, {"female", 1}});
+    EXPECT_EQ(codes, (Series{np::Array<np::float_>{0.0, 1.0, np::NaN, np::NaN, 1.0}, "sex"}));
+
+    std::vector<internal::Value> labels{"a", "b"};
+    Series labelled{np::Array<np::int_>{1, 2}, labels, "code"};
+    EXPECT_EQ(labelled.replace({{1, 3}}).index().getIndex(), labels);
+    EXPECT_EQ(labelled.map({{1, "one"}}).index().getIndex(), labels);
+}
+
+TEST_F(SeriesTest, isinTest) {
+    Series pregnancies{np::Array<np::int_>{6, 1, 8, 1, 0, 5, 3, 10}, "Pregnancies"};
+    EXPECT_EQ(pregnancies.isin({1, 8.0}), (std::vector<bool>{false, true, true, true, false, false, false, false}));
+    EXPECT_EQ(pregnancies.iloc(pregnancies.isin({1, 10})), (Series{np::Array<np::int_>{1, 1, 10}, "Pregnancies"}));
+    Series labelled{np::Array<np::int_>{6, 1, 8}, std::vector<internal::Value>{"a", "b", "c"}, "Pregnancies"};
+    EXPECT_EQ(labelled.iloc(std::vector<bool>{false, true, true}).index().getIndex(), (std::vector<internal::Value>{"b", "c"}));
+
+    // Dense range (bitmap), sparse keys (hash table) and an allowlist large enough for the Bloom filter
+    np::Array<np::int_> events{np::Shape{100000}};
+    for (np::Size i = 0; i < events.size(); ++i) {
+        events.set(i, static_cast<np::int_>(i * 7919 % 1000003));
+    }
+    Series series{events};
+    for (np::int_ step: {2, 1000, 9973}) {
+        std::vector<internal::Value> allowlist;
+        for (np::int_ key = 0; key < 1000003; key += step) {
+            allowlist.emplace_back(key);
+        }
+        if (step == 1000) {
+            // Far apart keys that never match
+            for (np::int_ key = 1; key <= 50000; ++key) {
+                allowlist.emplace_back(-key * 1000000007);
+            }
+        }
+        auto mask = series.isin(allowlist);
+        for (np::Size i = 0; i < events.size(); ++i) {
+            ASSERT_EQ(mask[i], events.get(i) % step == 0) << step << " " << i;
+        }
+    }
+
+    Series names{np::Array<np::string_>{"a", "b", "c"}};
+    std::vector<internal::Value> letters;
+    for (char c = 'b'; c <= 'z'; ++c) {
+        letters.emplace_back(np::string_(1, c));
+    }
+    EXPECT_EQ(names.isin(letters), (std::vector<bool>{false, true, true}));
+}
+
+TEST_F(SeriesTest, dotTest) {
+    Series ints1{np::Array<np::int_>{1, -2, 3, 4, 5}};
+    Series ints2{np::Array<np::int_>{2, 2, 2, 2, -1}};
+    EXPECT_EQ(ints1.dot(ints2), internal::Value{np::int_{7}});
+
+    Series floats{np::Array<np::float_>{0.5, 1.0, 1.5, 2.0, 2.5}};
+    EXPECT_DOUBLE_EQ(static_cast<np::float_>(ints1.dot(floats)), 0.5 - 2.0 + 4.5 + 8.0 + 12.5);
+
+    // 1 followed by many tiny values: naive summation loses them, compensated and pairwise keep most
+    const np::Size size = 1 << 20;
+    np::Array<np::float_> values{np::Shape{size}};
+    np::Array<np::float_> ones{np::Shape{size}};
+    values.set(0, 1.0);
+    ones.set(0, 1.0);
+    for (np::Size i = 1; i < size; ++i) {
+        values.set(i, 1e-16);
+        ones.set(i, 1.0);
+    }
+    auto expected = 1.0 + static_cast<np::float_>(size - 1) * 1e-16;
+    auto compensated = static_cast<np::float_>(Series{values}.dot(Series{ones}, Summation::kCompensated));
+    auto pairwise = static_cast<np::float_>(Series{values}.dot(Series{ones}, Summation::kPairwise));
+    auto fast = static_cast<np::float_>(Series{values}.dot(Series{ones}, Summation::kFast));
+    EXPECT_NEAR(compensated, expected, 1e-15);
+    EXPECT_NEAR(pairwise, expected, 1e-13);
+    EXPECT_NEAR(fast, expected, 1e-9);
+}